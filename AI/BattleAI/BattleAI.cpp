@@ -15,6 +15,7 @@
 #include "StackWithBonuses.h"
 #include "EnemyInfo.h"
 #include "tbb/parallel_for.h"
+#include "../../lib/CConfigHandler.h"
 #include "../../lib/CStopWatch.h"
 #include "../../lib/CThreadHelper.h"
 #include "../../lib/mapObjects/CGTownInstance.h"
@@ -142,6 +143,9 @@ void CBattleAI::activeStack(const BattleID & battleID, const CStack * stack )
 
 		BattleEvaluator evaluator(env, cb, stack, playerID, battleID, side, getStrengthRatio(cb->getBattle(battleID), side));
 
+		// 0 means that evaluation is not limited in time
+		evaluator.setTimeBudget(settings["server"]["battleAITimeBudget"].Integer());
+
 		result = evaluator.selectStackAction(stack);
 
 		if(autobattlePreferences.enableSpellsUsage && !skipCastUntilNextBattle && evaluator.canCastSpell())
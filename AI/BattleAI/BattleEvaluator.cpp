@@ -126,6 +126,13 @@ BattleAction BattleEvaluator::selectStackAction(const CStack * stack)
 
 		auto evaluationResult = scoreEvaluator.findBestTarget(stack, *targets, damageCache, hb);
 		auto & bestAttack = evaluationResult.bestAttack;
+		auto & stats = scoreEvaluator.getStats();
+
+		logAi->debug("BattleAI: evaluated %d attack candidates (%d skipped) in %d ms, %2f per second",
+			stats.evaluated,
+			stats.skipped,
+			stats.timeSpentMs,
+			stats.candidatesPerSecond());
 
 		cachedAttack = bestAttack;
 		cachedScore = evaluationResult.score;
@@ -542,6 +549,12 @@ bool BattleEvaluator::attemptCastingSpell(const CStack * activeStack)
 			{
 				auto & ps = possibleCasts[i];
 
+				if(scoreEvaluator.isTimeBudgetExceeded())
+				{
+					ps.value = EvaluationResult::INEFFECTIVE_SCORE;
+					continue;
+				}
+
 #if BATTLE_TRACE_LEVEL >= 1
 				logAi->trace("Evaluating %s", ps.spell->getNameTranslated());
 #endif
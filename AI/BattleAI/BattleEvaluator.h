@@ -47,6 +47,7 @@ public:
 	std::vector<BattleHex> getBrokenWallMoatHexes() const;
 	void evaluateCreatureSpellcast(const CStack * stack, PossibleSpellcast & ps); //for offensive damaging spells only
 	void print(const std::string & text) const;
+	void setTimeBudget(uint32_t milliseconds) { scoreEvaluator.setTimeBudget(milliseconds); }
 
 	BattleEvaluator(
 		std::shared_ptr<Environment> env,
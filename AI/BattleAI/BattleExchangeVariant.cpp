@@ -10,6 +10,7 @@
 #include "StdInc.h"
 #include "BattleExchangeVariant.h"
 #include "../../lib/CStack.h"
+#include "tbb/parallel_for.h"
 
 AttackerValue::AttackerValue()
 	: value(0),
@@ -235,14 +236,16 @@ EvaluationResult BattleExchangeEvaluator::findBestTarget(
 
 		updateReachabilityMap(hbWaited);
 
-		for(auto & ap : targets.possibleAttacks)
+		auto scores = evaluateAttacks(targets, damageCache, hbWaited);
+
+		for(size_t i = 0; i < targets.possibleAttacks.size(); i++)
 		{
-			float score = evaluateExchange(ap, 0, targets, damageCache, hbWaited);
+			float score = scores[i];
 
 			if(score > result.score)
 			{
 				result.score = score;
-				result.bestAttack = ap;
+				result.bestAttack = targets.possibleAttacks[i];
 				result.wait = true;
 
 #if BATTLE_TRACE_LEVEL >= 1
@@ -266,14 +269,16 @@ EvaluationResult BattleExchangeEvaluator::findBestTarget(
 			return result; // lets wait
 	}
 
-	for(auto & ap : targets.possibleAttacks)
+	auto scores = evaluateAttacks(targets, damageCache, hb);
+
+	for(size_t i = 0; i < targets.possibleAttacks.size(); i++)
 	{
-		float score = evaluateExchange(ap, 0, targets, damageCache, hb);
+		float score = scores[i];
 
 		if(score > result.score || (vstd::isAlmostEqual(score, result.score) && result.wait))
 		{
 			result.score = score;
-			result.bestAttack = ap;
+			result.bestAttack = targets.possibleAttacks[i];
 			result.wait = false;
 
 #if BATTLE_TRACE_LEVEL >= 1
@@ -285,6 +290,73 @@ EvaluationResult BattleExchangeEvaluator::findBestTarget(
 	return result;
 }
 
+std::vector<float> BattleExchangeEvaluator::evaluateAttacks(
+	PotentialTargets & targets,
+	DamageCache & damageCache,
+	std::shared_ptr<HypotheticBattle> hb)
+{
+	const auto & attacks = targets.possibleAttacks;
+	std::vector<float> scores(attacks.size(), EvaluationResult::INEFFECTIVE_SCORE);
+	std::vector<size_t> order(attacks.size());
+
+	// most promising attacks go first so running out of time drops only the weak ones
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) -> bool
+		{
+			return attacks[lhs].damageDiff() > attacks[rhs].damageDiff();
+		});
+
+	std::atomic<uint32_t> evaluated(0);
+	std::atomic<uint32_t> skipped(0);
+	auto start = std::chrono::steady_clock::now();
+
+#if BATTLE_TRACE_LEVEL >= 1
+	tbb::blocked_range<size_t> r(0, order.size());
+#else
+	tbb::parallel_for(tbb::blocked_range<size_t>(0, order.size()), [&](const tbb::blocked_range<size_t> & r)
+		{
+#endif
+			// damage cache is not thread safe, each task fills its own copy
+			DamageCache localCache = damageCache;
+
+			for(auto i = r.begin(); i != r.end(); i++)
+			{
+				// best candidate is always evaluated so we have something to fall back to
+				if(i != 0 && isTimeBudgetExceeded())
+				{
+					skipped++;
+					continue;
+				}
+
+				auto index = order[i];
+
+				scores[index] = evaluateExchange(attacks[index], 0, targets, localCache, hb);
+				evaluated++;
+			}
+#if BATTLE_TRACE_LEVEL == 0
+		});
+#endif
+
+	stats.evaluated += evaluated;
+	stats.skipped += skipped;
+	stats.timeSpentMs += std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+	return scores;
+}
+
+void BattleExchangeEvaluator::setTimeBudget(uint32_t milliseconds)
+{
+	if(milliseconds)
+		deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(milliseconds);
+	else
+		deadline.reset();
+}
+
+bool BattleExchangeEvaluator::isTimeBudgetExceeded() const
+{
+	return deadline && std::chrono::steady_clock::now() > *deadline;
+}
+
 MoveTarget BattleExchangeEvaluator::findMoveTowardsUnreachable(
 	const battle::Unit * activeStack,
 	PotentialTargets & targets,
@@ -402,7 +474,7 @@ ReachabilityData BattleExchangeEvaluator::getExchangeUnits(
 
 	for(auto hex : hexes)
 	{
-		vstd::concatenate(allReachableUnits, turn == 0 ? reachabilityMap[hex] : getOneTurnReachableUnits(turn, hex));
+		vstd::concatenate(allReachableUnits, turn == 0 ? getReachableUnits(hex) : getOneTurnReachableUnits(turn, hex));
 	}
 
 	vstd::removeDuplicates(allReachableUnits);
@@ -621,7 +693,7 @@ BattleScore BattleExchangeEvaluator::calculateExchange(
 						if(!exchangeBattle->getForUpdate(u->unitId())->alive())
 							return false;
 
-						return vstd::contains_if(reachabilityMap[u->getPosition()], [&](const battle::Unit * other) -> bool
+						return vstd::contains_if(getReachableUnits(u->getPosition()), [&](const battle::Unit * other) -> bool
 							{
 								return attacker->unitId() == other->unitId();
 							});
@@ -675,15 +747,6 @@ BattleScore BattleExchangeEvaluator::calculateExchange(
 			});
 	}
 
-	// avoid blocking path for stronger stack by weaker stack
-	// the method checks if all stacks can be placed around enemy
-	std::map<BattleHex, battle::Units> reachabilityMap;
-
-	auto hexes = ap.attack.defender->getSurroundingHexes();
-
-	for(auto hex : hexes)
-		reachabilityMap[hex] = getOneTurnReachableUnits(turn, hex);
-
 #if BATTLE_TRACE_LEVEL>=1
 	logAi->trace("Exchange score: enemy: %2f, our -%2f", v.getScore().enemyDamageReduce, v.getScore().ourDamageReduce);
 #endif
@@ -695,7 +758,7 @@ bool BattleExchangeEvaluator::canBeHitThisTurn(const AttackPossibility & ap)
 {
 	for(auto pos : ap.attack.attacker->getSurroundingHexes())
 	{
-		for(auto u : reachabilityMap[pos])
+		for(auto u : getReachableUnits(pos))
 		{
 			if(u->unitSide() != ap.attack.attacker->unitSide())
 			{
@@ -732,6 +795,15 @@ void BattleExchangeEvaluator::updateReachabilityMap(std::shared_ptr<HypotheticBa
 	}
 }
 
+const std::vector<const battle::Unit *> & BattleExchangeEvaluator::getReachableUnits(BattleHex hex) const
+{
+	static const std::vector<const battle::Unit *> noUnits;
+
+	auto iter = reachabilityMap.find(hex);
+
+	return iter == reachabilityMap.end() ? noUnits : iter->second;
+}
+
 std::vector<const battle::Unit *> BattleExchangeEvaluator::getOneTurnReachableUnits(uint8_t turn, BattleHex hex)
 {
 	std::vector<const battle::Unit *> result;
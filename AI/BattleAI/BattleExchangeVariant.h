@@ -62,6 +62,18 @@ struct MoveTarget
 	MoveTarget();
 };
 
+struct AttackEvaluationStats
+{
+	uint32_t evaluated = 0;
+	uint32_t skipped = 0;
+	int64_t timeSpentMs = 0;
+
+	float candidatesPerSecond() const
+	{
+		return timeSpentMs > 0 ? evaluated * 1000.0f / timeSpentMs : static_cast<float>(evaluated);
+	}
+};
+
 struct EvaluationResult
 {
 	static const int64_t INEFFECTIVE_SCORE = -10000;
@@ -131,9 +143,20 @@ private:
 	std::map<BattleHex, std::vector<const battle::Unit *>> reachabilityMap;
 	std::vector<battle::Units> turnOrder;
 	float negativeEffectMultiplier;
+	std::optional<std::chrono::steady_clock::time_point> deadline;
+	AttackEvaluationStats stats;
 
 	float scoreValue(const BattleScore & score) const;
 
+	/// Evaluates exchanges of all attack possibilities in parallel. Candidates which
+	/// did not fit into time budget are left with INEFFECTIVE_SCORE.
+	std::vector<float> evaluateAttacks(
+		PotentialTargets & targets,
+		DamageCache & damageCache,
+		std::shared_ptr<HypotheticBattle> hb);
+
+	const std::vector<const battle::Unit *> & getReachableUnits(BattleHex hex) const;
+
 	BattleScore calculateExchange(
 		const AttackPossibility & ap,
 		uint8_t turn,
@@ -183,6 +206,11 @@ public:
 
 	std::vector<const battle::Unit *> getAdjacentUnits(const battle::Unit * unit) const;
 
+	/// Limits time spent in further evaluations, 0 means no limit
+	void setTimeBudget(uint32_t milliseconds);
+	bool isTimeBudgetExceeded() const;
+	const AttackEvaluationStats & getStats() const { return stats; }
+
 	float getPositiveEffectMultiplier() const { return 1; }
 	float getNegativeEffectMultiplier() const { return negativeEffectMultiplier; }
 };
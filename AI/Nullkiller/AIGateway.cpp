@@ -386,7 +386,7 @@ void AIGateway::objectRemoved(const CGObjectInstance * obj, const PlayerColor &
 
 	if(obj->ID == Obj::HERO && cb->getPlayerRelations(obj->tempOwner, playerID) == PlayerRelations::ENEMIES)
 	{
-		nullkiller->dangerHitMap->reset();
+		nullkiller->dangerHitMap->resetPlayerThreats(obj->tempOwner);
 	}
 }
 
@@ -500,10 +500,11 @@ void AIGateway::objectPropertyChanged(const SetObjectProperty * sop)
 				//addVisitableObj(obj); // TODO: Remove once save compatability broken. In past owned objects were removed from this set
 				nullkiller->memory->markObjectUnvisited(obj);
 			}
-			else if(relations == PlayerRelations::SAME_PLAYER && obj->ID == Obj::TOWN)
+
+			if(obj->ID == Obj::TOWN)
 			{
-				// reevaluate defence for a new town
-				nullkiller->dangerHitMap->reset();
+				// reevaluate defence and tile owners once town is captured by anyone
+				nullkiller->dangerHitMap->resetTownOwners(dynamic_cast<const CGTownInstance *>(obj));
 			}
 		}
 	}
@@ -1148,13 +1149,15 @@ void AIGateway::waitTillFree()
 
 void AIGateway::retrieveVisitableObjs()
 {
-	foreach_tile_pos([&](const int3 & pos)
+	int3 mapSize = myCb->getMapSize();
+
+	for(int z = 0; z < mapSize.z; z++)
 	{
-		for(const CGObjectInstance * obj : myCb->getVisitableObjs(pos, false))
+		for(const CGObjectInstance * obj : myCb->getVisitableObjsInRange(int3(0, 0, z), mapSize.x + mapSize.y, std::nullopt))
 		{
 			addVisitableObj(obj);
 		}
-	});
+	}
 }
 
 std::vector<const CGObjectInstance *> AIGateway::getFlaggedObjects() const
@@ -1177,7 +1180,7 @@ void AIGateway::addVisitableObj(const CGObjectInstance * obj)
 
 	if(obj->ID == Obj::HERO && cb->getPlayerRelations(obj->tempOwner, playerID) == PlayerRelations::ENEMIES)
 	{
-		nullkiller->dangerHitMap->reset();
+		nullkiller->dangerHitMap->resetPlayerThreats(obj->tempOwner);
 	}
 }
 
@@ -23,6 +23,31 @@ double HitMapInfo::value() const
 	return danger / std::sqrt(turn / 3.0f + 1);
 }
 
+static HitMapInfo makeThreat(const AIPathView & path)
+{
+	HitMapInfo threat;
+
+	threat.hero = path.targetHero();
+	threat.turn = path.turn();
+	threat.danger = path.getHeroStrength();
+
+	return threat;
+}
+
+static void addThreat(HitMapInfo & maximumDanger, HitMapInfo & fastestDanger, const HitMapInfo & threat)
+{
+	if(threat.value() > maximumDanger.value())
+	{
+		maximumDanger = threat;
+	}
+
+	if(threat.turn < fastestDanger.turn
+		|| (threat.turn == fastestDanger.turn && fastestDanger.danger < threat.danger))
+	{
+		fastestDanger = threat;
+	}
+}
+
 void DangerHitMapAnalyzer::updateHitMap()
 {
 	if(hitMapUpToDate)
@@ -39,110 +64,167 @@ void DangerHitMapAnalyzer::updateHitMap()
 	if(hitMap.shape()[0] != mapSize.x || hitMap.shape()[1] != mapSize.y || hitMap.shape()[2] != mapSize.z)
 		hitMap.resize(boost::extents[mapSize.x][mapSize.y][mapSize.z]);
 
-	enemyHeroAccessibleObjects.clear();
-	townThreats.clear();
-
 	std::map<PlayerColor, std::map<const CGHeroInstance *, HeroRole>> heroes;
+	// neutral towns are not known to callback, but can be captured and defended later
+	auto towns = cb->getTownsInfo(false);
 
 	for(const CGObjectInstance * obj : ai->memory->visitableObjs)
 	{
-		if(obj->ID == Obj::HERO)
+		if(obj->ID == Obj::HERO
+			&& obj->tempOwner.isValidPlayer()
+			&& cb->getPlayerRelations(ai->playerID, obj->tempOwner) == PlayerRelations::ENEMIES)
 		{
 			auto hero = dynamic_cast<const CGHeroInstance *>(obj);
 
 			heroes[hero->tempOwner][hero] = HeroRole::MAIN;
 		}
-	}
-
-	auto ourTowns = cb->getTownsInfo();
 
-	for(auto town : ourTowns)
-	{
-		townThreats[town->id]; // insert empty list
+		if(obj->ID == Obj::TOWN && !obj->tempOwner.isValidPlayer())
+		{
+			towns.push_back(dynamic_cast<const CGTownInstance *>(obj));
+		}
 	}
 
-	foreach_tile_pos([&](const int3 & pos){
-		hitMap[pos.x][pos.y][pos.z].reset();
+	vstd::erase_if(enemyThreats, [&](const std::pair<const PlayerColor, EnemyThreatLayer> & layer) -> bool
+	{
+		return !vstd::contains(heroes, layer.first);
 	});
 
-	for(auto pair : heroes)
+	int updatedPlayers = 0;
+
+	for(auto & pair : heroes)
 	{
-		if(!pair.first.isValidPlayer())
-			continue;
+		auto & layer = enemyThreats[pair.first];
 
-		if(ai->cb->getPlayerRelations(ai->playerID, pair.first) != PlayerRelations::ENEMIES)
+		// enemies do not move during our turn, so paths are recalculated only when visible heroes change
+		if(layer.heroes == pair.second && !vstd::contains(outdatedPlayers, pair.first))
 			continue;
 
-		PathfinderSettings ps;
+		layer.heroes = pair.second;
+		updateEnemyThreats(layer, towns);
+		updatedPlayers++;
+	}
 
-		ps.scoutTurnDistanceLimit = ps.mainTurnDistanceLimit = ai->settings->getMainHeroTurnDistanceLimit();
-		ps.useHeroChain = false;
+	outdatedPlayers.clear();
+	mergeEnemyThreats();
 
-		ai->pathfinder->updatePaths(pair.second, ps);
+	logAi->debug("Danger hit map updated in %ld, threats of %d of %d enemy players recalculated",
+		timeElapsed(start),
+		updatedPlayers,
+		enemyThreats.size());
+}
+
+void DangerHitMapAnalyzer::updateEnemyThreats(EnemyThreatLayer & layer, const std::vector<const CGTownInstance *> & towns) const
+{
+	PathfinderSettings ps;
 
-		boost::this_thread::interruption_point();
+	ps.scoutTurnDistanceLimit = ps.mainTurnDistanceLimit = ai->settings->getMainHeroTurnDistanceLimit();
+	ps.useHeroChain = false;
 
-		pforeachTilePos(mapSize, [&](const int3 & pos)
+	ai->pathfinder->updatePaths(layer.heroes, ps);
+
+	boost::this_thread::interruption_point();
+
+	layer.tiles.clear();
+	layer.townThreats.clear();
+	layer.accessibleTowns.clear();
+
+	pforeachTilePos(ai->cb->getMapSize(), [&](const int3 & pos)
+	{
+		EnemyThreatLayer::TileThreat threat;
+		bool threatened = false;
+
+		for(const AIPathView & path : ai->pathfinder->getPathViews(pos))
 		{
-			for(AIPath & path : ai->pathfinder->getPathInfo(pos))
-			{
-				if(path.getFirstBlockedAction())
-					continue;
+			if(path.hasBlockedAction())
+				continue;
 
-				auto & node = hitMap[pos.x][pos.y][pos.z];
+			addThreat(threat.maximumDanger, threat.fastestDanger, makeThreat(path));
+			threatened = true;
+		}
 
-				HitMapInfo newThreat;
+		if(threatened)
+		{
+			threat.tile = pos;
+			layer.tiles.push_back(threat);
+		}
+	});
 
-				newThreat.hero = path.targetHero;
-				newThreat.turn = path.turn();
-				newThreat.danger = path.getHeroStrength();
+	// towns are few, so their threats are collected after parallel pass without locking
+	for(auto town : towns)
+	{
+		auto & threats = layer.townThreats[town->id];
 
-				if(newThreat.value() > node.maximumDanger.value())
-				{
-					node.maximumDanger = newThreat;
-				}
+		for(const AIPathView & path : ai->pathfinder->getPathViews(town->visitablePos()))
+		{
+			if(path.hasBlockedAction())
+				continue;
 
-				if(newThreat.turn < node.fastestDanger.turn
-					|| (newThreat.turn == node.fastestDanger.turn && node.fastestDanger.danger < newThreat.danger))
+			auto newThreat = makeThreat(path);
+			auto threat = std::find_if(threats.begin(), threats.end(), [&](const HitMapInfo & i) -> bool
 				{
-					node.fastestDanger = newThreat;
-				}
+					return i.hero.hid == path.targetHero()->id;
+				});
 
-				auto objects = cb->getVisitableObjs(pos, false);
+			if(threat == threats.end())
+			{
+				threats.emplace_back();
+				threat = std::prev(threats.end(), 1);
+			}
 
-				for(auto obj : objects)
-				{
-					if(obj->ID == Obj::TOWN && obj->getOwner() == ai->playerID)
-					{
-						auto & threats = townThreats[obj->id];
-						auto threat = std::find_if(threats.begin(), threats.end(), [&](const HitMapInfo & i) -> bool
-							{
-								return i.hero.hid == path.targetHero->id;
-							});
-
-						if(threat == threats.end())
-						{
-							threats.emplace_back();
-							threat = std::prev(threats.end(), 1);
-						}
-
-						if(newThreat.value() > threat->value())
-						{
-							*threat = newThreat;
-						}
-
-						if(newThreat.turn == 0)
-						{
-							if(cb->getPlayerRelations(obj->tempOwner, ai->playerID) != PlayerRelations::ENEMIES)
-								enemyHeroAccessibleObjects.emplace_back(path.targetHero, obj);
-						}
-					}
-				}
+			if(newThreat.value() > threat->value())
+			{
+				*threat = newThreat;
 			}
-		});
+
+			if(newThreat.turn == 0)
+			{
+				layer.accessibleTowns.emplace_back(path.targetHero(), town);
+			}
+		}
 	}
+}
+
+void DangerHitMapAnalyzer::mergeEnemyThreats()
+{
+	enemyHeroAccessibleObjects.clear();
+	townThreats.clear();
+
+	for(auto town : ai->cb->getTownsInfo())
+	{
+		townThreats[town->id]; // insert empty list
+	}
+
+	foreach_tile_pos([&](const int3 & pos){
+		hitMap[pos.x][pos.y][pos.z].reset();
+	});
+
+	for(auto & pair : enemyThreats)
+	{
+		const EnemyThreatLayer & layer = pair.second;
 
-	logAi->trace("Danger hit map updated in %ld", timeElapsed(start));
+		for(auto & threat : layer.tiles)
+		{
+			auto & node = hitMap[threat.tile.x][threat.tile.y][threat.tile.z];
+
+			addThreat(node.maximumDanger, node.fastestDanger, threat.maximumDanger);
+			addThreat(node.maximumDanger, node.fastestDanger, threat.fastestDanger);
+		}
+
+		for(auto & townThreat : layer.townThreats)
+		{
+			auto ourTown = townThreats.find(townThreat.first);
+
+			if(ourTown != townThreats.end())
+				vstd::concatenate(ourTown->second, townThreat.second);
+		}
+
+		for(auto & accessible : layer.accessibleTowns)
+		{
+			if(accessible.obj->getOwner() == ai->playerID)
+				enemyHeroAccessibleObjects.push_back(accessible);
+		}
+	}
 }
 
 void DangerHitMapAnalyzer::calculateTileOwners()
@@ -150,6 +232,7 @@ void DangerHitMapAnalyzer::calculateTileOwners()
 	if(tileOwnersUpToDate) return;
 
 	tileOwnersUpToDate = true;
+	auto start = std::chrono::high_resolution_clock::now();
 
 	auto cb = ai->cb.get();
 	auto mapSize = ai->cb->getMapSize();
@@ -201,12 +284,12 @@ void DangerHitMapAnalyzer::calculateTileOwners()
 			const CGTownInstance * enemyTown = nullptr;
 			const CGTownInstance * ourTown = nullptr;
 
-			for(AIPath & path : ai->pathfinder->getPathInfo(pos))
+			for(const AIPathView & path : ai->pathfinder->getPathViews(pos))
 			{
-				if(!path.targetHero || path.getFirstBlockedAction())
+				if(path.hasBlockedAction())
 					continue;
 
-				auto town = heroTownMap[path.targetHero];
+				auto town = heroTownMap.at(path.targetHero());
 
 				if(town->getOwner() == ai->playerID)
 				{
@@ -239,6 +322,8 @@ void DangerHitMapAnalyzer::calculateTileOwners()
 				hitMap[pos.x][pos.y][pos.z].closestTown = enemyTown;
 			}
 		});
+
+	logAi->debug("Tile owners calculated for %d towns in %ld", heroTownMap.size(), timeElapsed(start));
 }
 
 const std::vector<HitMapInfo> & DangerHitMapAnalyzer::getTownThreats(const CGTownInstance * town) const
@@ -301,6 +386,27 @@ std::set<const CGObjectInstance *> DangerHitMapAnalyzer::getOneTurnAccessibleObj
 void DangerHitMapAnalyzer::reset()
 {
 	hitMapUpToDate = false;
+	enemyThreats.clear();
+	outdatedPlayers.clear();
+}
+
+void DangerHitMapAnalyzer::resetPlayerThreats(const PlayerColor & player)
+{
+	hitMapUpToDate = false;
+	outdatedPlayers.insert(player);
+}
+
+void DangerHitMapAnalyzer::resetTownOwners(const CGTownInstance * town)
+{
+	hitMapUpToDate = false;
+	tileOwnersUpToDate = false;
+
+	// town was not visible when layers were calculated, so its threats have to be collected again
+	for(auto & pair : enemyThreats)
+	{
+		if(!vstd::contains(pair.second.townThreats, town->id))
+			outdatedPlayers.insert(pair.first);
+	}
 }
 
 }
@@ -66,6 +66,23 @@ struct EnemyHeroAccessibleObject
 	}
 };
 
+/// Threats of visible heroes of single enemy player.
+/// Enemies do not move during our turn, so layer is kept until heroes of its player change
+struct EnemyThreatLayer
+{
+	struct TileThreat
+	{
+		int3 tile;
+		HitMapInfo maximumDanger;
+		HitMapInfo fastestDanger;
+	};
+
+	std::map<const CGHeroInstance *, HeroRole> heroes;
+	tbb::concurrent_vector<TileThreat> tiles;
+	std::map<ObjectInstanceID, std::vector<HitMapInfo>> townThreats;
+	std::vector<EnemyHeroAccessibleObject> accessibleTowns;
+};
+
 class DangerHitMapAnalyzer
 {
 private:
@@ -75,6 +92,11 @@ private:
 	bool tileOwnersUpToDate = false;
 	const Nullkiller * ai;
 	std::map<ObjectInstanceID, std::vector<HitMapInfo>> townThreats;
+	std::map<PlayerColor, EnemyThreatLayer> enemyThreats;
+	std::set<PlayerColor> outdatedPlayers;
+
+	void updateEnemyThreats(EnemyThreatLayer & layer, const std::vector<const CGTownInstance *> & towns) const;
+	void mergeEnemyThreats();
 
 public:
 	DangerHitMapAnalyzer(const Nullkiller * ai) :ai(ai) {}
@@ -85,7 +107,12 @@ public:
 	const HitMapNode & getObjectThreat(const CGObjectInstance * obj) const;
 	const HitMapNode & getTileThreat(const int3 & tile) const;
 	std::set<const CGObjectInstance *> getOneTurnAccessibleObjects(const CGHeroInstance * enemy) const;
+	/// Drops all cached threats, called once enemies could have moved
 	void reset();
+	/// Recalculates threats only of given player on next update
+	void resetPlayerThreats(const PlayerColor & player);
+	/// Town threats are merged again on next update and tile owners are recalculated
+	void resetTownOwners(const CGTownInstance * town);
 	void resetTileOwners() { tileOwnersUpToDate = false; }
 	PlayerColor getTileOwner(const int3 & tile) const;
 	const CGTownInstance * getClosestTown(const int3 & tile) const;
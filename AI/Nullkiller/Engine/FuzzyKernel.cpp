@@ -0,0 +1,343 @@
+/*
+* FuzzyKernel.cpp, part of VCMI engine
+*
+* Authors: listed in file AUTHORS in main folder
+*
+* License: GNU General Public License v2.0 or later
+* Full text of license available in license.txt file, in main folder
+*
+*/
+#include "StdInc.h"
+#include "FuzzyKernel.h"
+
+namespace NKAI
+{
+
+std::optional<FuzzyKernel::Norm> FuzzyKernel::compileNorm(const fl::Norm * norm)
+{
+	if(!norm)
+		return std::nullopt;
+
+	static const std::map<std::string, Norm> supportedNorms = {
+		{ "AlgebraicProduct", Norm::ALGEBRAIC_PRODUCT },
+		{ "Minimum", Norm::MINIMUM },
+		{ "AlgebraicSum", Norm::ALGEBRAIC_SUM },
+		{ "Maximum", Norm::MAXIMUM },
+		{ "NormalizedSum", Norm::NORMALIZED_SUM }
+	};
+
+	auto found = supportedNorms.find(norm->className());
+
+	if(found == supportedNorms.end())
+		return std::nullopt;
+
+	return found->second;
+}
+
+fl::scalar FuzzyKernel::computeNorm(Norm norm, fl::scalar a, fl::scalar b)
+{
+	switch(norm)
+	{
+	case Norm::ALGEBRAIC_PRODUCT:
+		return a * b;
+	case Norm::MINIMUM:
+		return std::min(a, b);
+	case Norm::ALGEBRAIC_SUM:
+		return a + b - a * b;
+	case Norm::MAXIMUM:
+		return std::max(a, b);
+	case Norm::NORMALIZED_SUM:
+		return (a + b) / std::max(fl::scalar(1.0), a + b);
+	}
+
+	return fl::nan;
+}
+
+std::unique_ptr<FuzzyKernel> FuzzyKernel::compile(const fl::Engine & engine)
+{
+	auto kernel = std::make_unique<FuzzyKernel>();
+	auto fail = [&engine](const std::string & reason) -> std::unique_ptr<FuzzyKernel>
+	{
+		logAi->warn("Fuzzy engine '%s' can not be compiled, fuzzylite will be used: %s", engine.getName(), reason);
+
+		return nullptr;
+	};
+
+	if(engine.outputVariables().size() != 1)
+		return fail("only engines with single output variable are supported");
+
+	const fl::OutputVariable * output = engine.outputVariables().front();
+
+	if(!output->isEnabled() || output->isLockPreviousValue())
+		return fail("output variable must be enabled and must not depend on previous value");
+
+	const auto * centroid = dynamic_cast<const fl::Centroid *>(output->getDefuzzifier());
+
+	if(!centroid)
+		return fail("only centroid defuzzifier is supported");
+
+	if(centroid->getResolution() <= 0 || static_cast<size_t>(centroid->getResolution()) > MAX_RESOLUTION)
+		return fail("unsupported defuzzifier resolution");
+
+	auto aggregation = compileNorm(output->fuzzyOutput()->getAggregation());
+
+	if(!aggregation)
+		return fail("unsupported aggregation");
+
+	kernel->resolution = centroid->getResolution();
+	kernel->aggregation = *aggregation;
+	kernel->minimum = output->getMinimum();
+	kernel->maximum = output->getMaximum();
+	kernel->defaultValue = output->getDefaultValue();
+	kernel->lockValueInRange = output->isLockValueInRange();
+	kernel->tolerance = fl::fuzzylite::macheps();
+
+	if(!std::isfinite(kernel->minimum + kernel->maximum))
+		return fail("output range must be finite");
+
+	// same sample points as used by fl::Centroid
+	fl::scalar dx = (kernel->maximum - kernel->minimum) / kernel->resolution;
+
+	for(size_t i = 0; i < kernel->resolution; i++)
+		kernel->samplePositions.push_back(kernel->minimum + (i + 0.5) * dx);
+
+	for(const fl::Term * term : output->terms())
+	{
+		for(fl::scalar x : kernel->samplePositions)
+			kernel->outputSamples.push_back(term->membership(x));
+	}
+
+	for(const fl::InputVariable * variable : engine.inputVariables())
+	{
+		if(!variable->isEnabled())
+			return fail("disabled input variables are not supported");
+
+		for(const fl::Term * term : variable->terms())
+			kernel->inputTerms.push_back({variable, term});
+	}
+
+	if(kernel->inputTerms.size() > MAX_INPUT_TERMS)
+		return fail("too many input terms");
+
+	for(const fl::RuleBlock * ruleBlock : engine.ruleBlocks())
+	{
+		if(!ruleBlock->isEnabled())
+			continue;
+
+		if(!ruleBlock->getActivation() || ruleBlock->getActivation()->className() != "General")
+			return fail("only general activation is supported in rule block " + ruleBlock->getName());
+
+		auto conjunction = compileNorm(ruleBlock->getConjunction());
+		auto disjunction = compileNorm(ruleBlock->getDisjunction());
+		auto implication = compileNorm(ruleBlock->getImplication());
+
+		if(!implication)
+			return fail("unsupported implication in rule block " + ruleBlock->getName());
+
+		for(const fl::Rule * rule : ruleBlock->rules())
+		{
+			if(!rule->isLoaded() || !rule->isEnabled())
+				continue;
+
+			const auto & conclusions = rule->getConsequent()->conclusions();
+
+			if(conclusions.size() != 1 || !conclusions.front()->hedges.empty() || conclusions.front()->variable != output)
+				return fail("only rules with single conclusion without hedges are supported: " + rule->getText());
+
+			const auto & outputTerms = output->terms();
+			auto outputTerm = std::find(outputTerms.begin(), outputTerms.end(), conclusions.front()->term);
+
+			Rule compiled;
+			std::string error;
+
+			compiled.weight = rule->getWeight();
+			compiled.outputTerm = static_cast<uint16_t>(outputTerm - outputTerms.begin());
+			compiled.conjunction = conjunction.value_or(Norm::ALGEBRAIC_PRODUCT);
+			compiled.disjunction = disjunction.value_or(Norm::ALGEBRAIC_SUM);
+			compiled.implication = *implication;
+
+			if(!kernel->compileExpression(rule->getAntecedent()->getExpression(), compiled.antecedent, error))
+				return fail(error + ": " + rule->getText());
+
+			// operands of postfix program are kept on fixed size stack during evaluation
+			size_t depth = 0;
+
+			for(const auto & instruction : compiled.antecedent)
+			{
+				if((instruction.type == Instruction::Type::AND && !conjunction)
+					|| (instruction.type == Instruction::Type::OR && !disjunction))
+				{
+					return fail("unsupported conjunction or disjunction in rule block " + ruleBlock->getName());
+				}
+
+				depth = instruction.type == Instruction::Type::TERM ? depth + 1 : depth - 1;
+
+				if(depth > MAX_EXPRESSION_DEPTH)
+					return fail("expression is too deep: " + rule->getText());
+			}
+
+			kernel->rules.push_back(std::move(compiled));
+		}
+	}
+
+	return kernel;
+}
+
+bool FuzzyKernel::compileExpression(const fl::Expression * expression, std::vector<Instruction> & program, std::string & error) const
+{
+	if(!expression)
+	{
+		error = "empty expression";
+		return false;
+	}
+
+	if(expression->type() == fl::Expression::Operator)
+	{
+		const auto * op = static_cast<const fl::Operator *>(expression);
+		Instruction instruction;
+
+		if(op->name == fl::Rule::andKeyword())
+			instruction.type = Instruction::Type::AND;
+		else if(op->name == fl::Rule::orKeyword())
+			instruction.type = Instruction::Type::OR;
+		else
+		{
+			error = "unknown operator " + op->name;
+			return false;
+		}
+
+		if(!compileExpression(op->left, program, error) || !compileExpression(op->right, program, error))
+			return false;
+
+		instruction.negate = false;
+		instruction.term = 0;
+		program.push_back(instruction);
+
+		return true;
+	}
+
+	const auto * proposition = static_cast<const fl::Proposition *>(expression);
+	Instruction instruction;
+
+	instruction.type = Instruction::Type::TERM;
+	instruction.negate = false;
+
+	for(const fl::Hedge * hedge : proposition->hedges)
+	{
+		if(hedge->name() != "not")
+		{
+			error = "only 'not' hedge is supported";
+			return false;
+		}
+
+		instruction.negate = !instruction.negate;
+	}
+
+	for(size_t i = 0; i < inputTerms.size(); i++)
+	{
+		if(inputTerms[i].variable == proposition->variable && inputTerms[i].term == proposition->term)
+		{
+			instruction.term = static_cast<uint16_t>(i);
+			program.push_back(instruction);
+
+			return true;
+		}
+	}
+
+	error = "antecedent may only use terms of input variables";
+	return false;
+}
+
+fl::scalar FuzzyKernel::evaluateAntecedent(const Rule & rule, const fl::scalar * degrees) const
+{
+	std::array<fl::scalar, MAX_EXPRESSION_DEPTH> stack;
+	size_t top = 0;
+
+	for(const auto & instruction : rule.antecedent)
+	{
+		switch(instruction.type)
+		{
+		case Instruction::Type::TERM:
+			stack[top++] = instruction.negate ? 1.0 - degrees[instruction.term] : degrees[instruction.term];
+			break;
+		case Instruction::Type::AND:
+			top--;
+			stack[top - 1] = computeNorm(rule.conjunction, stack[top - 1], stack[top]);
+			break;
+		case Instruction::Type::OR:
+			top--;
+			stack[top - 1] = computeNorm(rule.disjunction, stack[top - 1], stack[top]);
+			break;
+		}
+	}
+
+	return stack[0];
+}
+
+void FuzzyKernel::aggregate(const Rule & rule, fl::scalar activation, fl::scalar * aggregated) const
+{
+	const fl::scalar * samples = outputSamples.data() + rule.outputTerm * resolution;
+
+	// default configuration of AI rules gets branch-free loop which compiler can vectorize
+	if(rule.implication == Norm::ALGEBRAIC_PRODUCT && aggregation == Norm::ALGEBRAIC_SUM)
+	{
+		for(size_t i = 0; i < resolution; i++)
+		{
+			fl::scalar activated = activation * samples[i];
+
+			aggregated[i] = aggregated[i] + activated - aggregated[i] * activated;
+		}
+
+		return;
+	}
+
+	for(size_t i = 0; i < resolution; i++)
+		aggregated[i] = computeNorm(aggregation, aggregated[i], computeNorm(rule.implication, samples[i], activation));
+}
+
+fl::scalar FuzzyKernel::evaluate() const
+{
+	std::array<fl::scalar, MAX_INPUT_TERMS> degrees;
+	std::array<fl::scalar, MAX_RESOLUTION> aggregated;
+	bool triggered = false;
+
+	for(size_t i = 0; i < inputTerms.size(); i++)
+		degrees[i] = inputTerms[i].term->membership(inputTerms[i].variable->getValue());
+
+	std::fill_n(aggregated.begin(), resolution, 0.0);
+
+	for(const auto & rule : rules)
+	{
+		fl::scalar activation = rule.weight * evaluateAntecedent(rule, degrees.data());
+
+		// fuzzylite triggers rule only if fl::Op::isGt(activation, 0)
+		if(!(activation >= tolerance))
+			continue;
+
+		triggered = true;
+		aggregate(rule, activation, aggregated.data());
+	}
+
+	fl::scalar result = defaultValue;
+
+	if(triggered)
+	{
+		fl::scalar area = 0;
+		fl::scalar centroid = 0;
+
+		for(size_t i = 0; i < resolution; i++)
+		{
+			centroid += aggregated[i] * samplePositions[i];
+			area += aggregated[i];
+		}
+
+		result = centroid / area;
+	}
+
+	if(lockValueInRange)
+		result = std::clamp(result, minimum, maximum);
+
+	return result;
+}
+
+}
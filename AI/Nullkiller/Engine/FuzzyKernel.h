@@ -0,0 +1,99 @@
+/*
+* FuzzyKernel.h, part of VCMI engine
+*
+* Authors: listed in file AUTHORS in main folder
+*
+* License: GNU General Public License v2.0 or later
+* Full text of license available in license.txt file, in main folder
+*
+*/
+#pragma once
+#if __has_include(<fuzzylite/Headers.h>)
+#  include <fuzzylite/Headers.h>
+#else
+#  include <fl/Headers.h>
+#endif
+
+namespace NKAI
+{
+
+/// Precompiled form of fuzzylite Mamdani engine with single output and centroid defuzzifier.
+/// Rules are flattened to postfix programs over input terms and output terms are sampled once
+/// at points used by centroid, so evaluation only does arithmetic over plain arrays and needs no fuzzylite state
+class FuzzyKernel
+{
+public:
+	static constexpr size_t MAX_INPUT_TERMS = 256;
+	static constexpr size_t MAX_RESOLUTION = 1024;
+	static constexpr size_t MAX_EXPRESSION_DEPTH = 16;
+
+	/// Returns nullptr and logs reason if engine uses features not supported by kernel
+	static std::unique_ptr<FuzzyKernel> compile(const fl::Engine & engine);
+
+	/// Evaluates output using current values of engine input variables, engine itself is not modified
+	fl::scalar evaluate() const;
+
+private:
+	enum class Norm : uint8_t
+	{
+		ALGEBRAIC_PRODUCT,
+		MINIMUM,
+		ALGEBRAIC_SUM,
+		MAXIMUM,
+		NORMALIZED_SUM
+	};
+
+	struct Instruction
+	{
+		enum class Type : uint8_t
+		{
+			TERM,
+			AND,
+			OR
+		};
+
+		Type type;
+		bool negate;
+		uint16_t term;
+	};
+
+	struct Rule
+	{
+		std::vector<Instruction> antecedent;
+		fl::scalar weight;
+		uint16_t outputTerm;
+		Norm conjunction;
+		Norm disjunction;
+		Norm implication;
+	};
+
+	struct InputTerm
+	{
+		const fl::InputVariable * variable;
+		const fl::Term * term;
+	};
+
+	std::vector<InputTerm> inputTerms;
+	std::vector<Rule> rules;
+
+	/// membership of each output term at each sample point, resolution values per term
+	std::vector<fl::scalar> outputSamples;
+	std::vector<fl::scalar> samplePositions;
+	size_t resolution = 0;
+	Norm aggregation = Norm::MAXIMUM;
+
+	fl::scalar minimum = 0;
+	fl::scalar maximum = 0;
+	fl::scalar defaultValue = 0;
+	bool lockValueInRange = false;
+	fl::scalar tolerance = 0;
+
+	static std::optional<Norm> compileNorm(const fl::Norm * norm);
+	static fl::scalar computeNorm(Norm norm, fl::scalar a, fl::scalar b);
+
+	bool compileExpression(const fl::Expression * expression, std::vector<Instruction> & program, std::string & error) const;
+	fl::scalar evaluateAntecedent(const Rule & rule, const fl::scalar * degrees) const;
+	void aggregate(const Rule & rule, fl::scalar activation, fl::scalar * aggregated) const;
+};
+
+}
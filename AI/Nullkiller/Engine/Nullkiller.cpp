@@ -21,15 +21,13 @@
 #include "../Behaviors/StayAtTownBehavior.h"
 #include "../Goals/Invalid.h"
 #include "../Goals/Composition.h"
+#include "../../../lib/ScopeGuard.h"
 
 namespace NKAI
 {
 
 using namespace Goals;
 
-// while we play vcmieagles graph can be shared
-std::unique_ptr<ObjectGraph> Nullkiller::baseGraph;
-
 Nullkiller::Nullkiller()
 	:activeHero(nullptr), scanDepth(ScanDepth::MAIN_FULL), useHeroChain(true)
 {
@@ -73,6 +71,15 @@ Goals::TTask Nullkiller::choseBestTask(Goals::TTaskVec & tasks) const
 }
 
 Goals::TTask Nullkiller::choseBestTask(Goals::TSubgoal behavior, int decompositionMaxDepth) const
+{
+	return choseBestTask(behavior, decompositionMaxDepth, *decomposer, *priorityEvaluator);
+}
+
+Goals::TTask Nullkiller::choseBestTask(
+	Goals::TSubgoal behavior,
+	int decompositionMaxDepth,
+	DeepDecomposer & decomposer,
+	PriorityEvaluator & evaluator) const
 {
 	boost::this_thread::interruption_point();
 
@@ -80,7 +87,7 @@ Goals::TTask Nullkiller::choseBestTask(Goals::TSubgoal behavior, int decompositi
 
 	auto start = std::chrono::high_resolution_clock::now();
 	
-	Goals::TGoalVec elementarGoals = decomposer->decompose(behavior, decompositionMaxDepth);
+	Goals::TGoalVec elementarGoals = decomposer.decompose(behavior, decompositionMaxDepth);
 	Goals::TTaskVec tasks;
 
 	boost::this_thread::interruption_point();
@@ -90,7 +97,7 @@ Goals::TTask Nullkiller::choseBestTask(Goals::TSubgoal behavior, int decompositi
 		Goals::TTask task = Goals::taskptr(*goal);
 
 		if(task->priority <= 0)
-			task->priority = priorityEvaluator->evaluate(goal);
+			task->priority = evaluator.evaluate(goal);
 
 		tasks.push_back(task);
 	}
@@ -114,6 +121,45 @@ Goals::TTask Nullkiller::choseBestTask(Goals::TSubgoal behavior, int decompositi
 	return task;
 }
 
+Goals::TTaskVec Nullkiller::choseBestTasks(const std::vector<std::pair<Goals::TSubgoal, int>> & behaviors) const
+{
+	Goals::TTaskVec tasks(behaviors.size());
+	auto * gateway = NKAI::ai;
+	auto * callback = NKAI::cb;
+	auto start = std::chrono::high_resolution_clock::now();
+
+#if NKAI_TRACE_LEVEL == 0
+	parallel_for(blocked_range<size_t>(0, behaviors.size(), 1), [&](const blocked_range<size_t> & r)
+	{
+#else
+	blocked_range<size_t> r(0, behaviors.size());
+#endif
+		// behaviors access AI through thread local pointers, worker thread may also be executing tasks of other AI
+		auto previousAi = std::exchange(NKAI::ai, gateway);
+		auto previousCb = std::exchange(NKAI::cb, callback);
+		auto restoreState = vstd::makeScopeGuard([previousAi, previousCb]()
+		{
+			NKAI::ai = previousAi;
+			NKAI::cb = previousCb;
+		});
+
+		auto evaluator = priorityEvaluators->acquire();
+		DeepDecomposer behaviorDecomposer;
+
+		for(size_t i = r.begin(); i != r.end(); i++)
+		{
+			behaviorDecomposer.reset();
+			tasks[i] = choseBestTask(behaviors[i].first, behaviors[i].second, behaviorDecomposer, *evaluator);
+		}
+#if NKAI_TRACE_LEVEL == 0
+	});
+#endif
+
+	logAi->debug("Evaluated %d behaviors, time taken %ld", behaviors.size(), timeElapsed(start));
+
+	return tasks;
+}
+
 void Nullkiller::resetAiState()
 {
 	std::unique_lock<std::mutex> lockGuard(aiStateMutex);
@@ -241,7 +287,11 @@ HeroLockedReason Nullkiller::getHeroLockedReason(const CGHeroInstance * hero) co
 
 void Nullkiller::makeTurn()
 {
-	boost::lock_guard<boost::mutex> sharedStorageLock(AISharedStorage::locker);
+	// other AI may be making turn at the same time, so path nodes are only taken from shared pool till the end of this turn
+	auto releaseNodes = vstd::makeScopeGuard([this]()
+	{
+		pathfinder->releaseNodes();
+	});
 
 	const int MAX_DEPTH = 10;
 	const float FAST_TASK_MINIMAL_PRIORITY = 0.7f;
@@ -274,21 +324,24 @@ void Nullkiller::makeTurn()
 			}
 		}
 
-		Goals::TTaskVec bestTasks = {
-			bestTask,
-			choseBestTask(sptr(RecruitHeroBehavior()), 1),
-			choseBestTask(sptr(CaptureObjectsBehavior()), 1),
-			choseBestTask(sptr(ClusterBehavior()), MAX_DEPTH),
-			choseBestTask(sptr(DefenceBehavior()), MAX_DEPTH),
-			choseBestTask(sptr(GatherArmyBehavior()), MAX_DEPTH),
-			choseBestTask(sptr(StayAtTownBehavior()), MAX_DEPTH)
+		std::vector<std::pair<Goals::TSubgoal, int>> behaviors = {
+			{sptr(RecruitHeroBehavior()), 1},
+			{sptr(CaptureObjectsBehavior()), 1},
+			{sptr(ClusterBehavior()), MAX_DEPTH},
+			{sptr(DefenceBehavior()), MAX_DEPTH},
+			{sptr(GatherArmyBehavior()), MAX_DEPTH},
+			{sptr(StayAtTownBehavior()), MAX_DEPTH}
 		};
 
 		if(cb->getDate(Date::DAY) == 1)
 		{
-			bestTasks.push_back(choseBestTask(sptr(StartupBehavior()), 1));
+			behaviors.push_back({sptr(StartupBehavior()), 1});
 		}
 
+		Goals::TTaskVec bestTasks = choseBestTasks(behaviors);
+
+		bestTasks.insert(bestTasks.begin(), bestTask);
+
 		bestTask = choseBestTask(bestTasks);
 
 		std::string taskDescription = bestTask->toString();
@@ -59,7 +59,7 @@ private:
 	bool useHeroChain;
 
 public:
-	static std::unique_ptr<ObjectGraph> baseGraph;
+	std::unique_ptr<ObjectGraph> baseGraph;
 
 	std::unique_ptr<DangerHitMapAnalyzer> dangerHitMap;
 	std::unique_ptr<BuildAnalyzer> buildAnalyzer;
@@ -102,7 +102,10 @@ private:
 	void resetAiState();
 	void updateAiState(int pass, bool fast = false);
 	Goals::TTask choseBestTask(Goals::TSubgoal behavior, int decompositionMaxDepth) const;
+	Goals::TTask choseBestTask(Goals::TSubgoal behavior, int decompositionMaxDepth, DeepDecomposer & decomposer, PriorityEvaluator & evaluator) const;
 	Goals::TTask choseBestTask(Goals::TTaskVec & tasks) const;
+	/// Evaluates behaviors concurrently, each with own decomposer and priority evaluator. Returns best task of each behavior
+	Goals::TTaskVec choseBestTasks(const std::vector<std::pair<Goals::TSubgoal, int>> & behaviors) const;
 	void executeTask(Goals::TTask task);
 };
 
@@ -89,6 +89,7 @@ void PriorityEvaluator::initVisitTile()
 	goldCostVariable = engine->getInputVariable("goldCost");
 	fearVariable = engine->getInputVariable("fear");
 	value = engine->getOutputVariable("Value");
+	kernel = FuzzyKernel::compile(*engine);
 }
 
 bool isAnotherAi(const CGObjectInstance * obj, const CPlayerSpecificInfoCallback & cb)
@@ -1043,7 +1044,7 @@ uint64_t RewardEvaluator::getUpgradeArmyReward(const CGTownInstance * town, cons
 }
 
 PriorityEvaluator::PriorityEvaluator(const Nullkiller * ai)
-	:ai(ai)
+	:ai(ai), verifyKernel(ai->settings->isFuzzyKernelVerified())
 {
 	initVisitTile();
 	evaluationContextBuilders.push_back(std::make_shared<ExecuteHeroChainEvaluationContextBuilder>(ai));
@@ -1116,9 +1117,26 @@ float PriorityEvaluator::evaluate(Goals::TSubgoal task)
 		turnVariable->setValue(evaluationContext.turn);
 		fearVariable->setValue(evaluationContext.enemyHeroDangerRatio);
 
-		engine->process();
+		if(kernel)
+		{
+			result = kernel->evaluate();
+
+			if(verifyKernel)
+			{
+				engine->process();
+
+				double expected = value->getValue();
+
+				if(std::abs(result - expected) > 1e-6 && !(std::isnan(result) && std::isnan(expected)))
+					logAi->error("Fuzzy kernel result %f differs from fuzzylite result %f for %s", result, expected, task->toString());
+			}
+		}
+		else
+		{
+			engine->process();
 
-		result = value->getValue();
+			result = value->getValue();
+		}
 	}
 	catch(fl::Exception & fe)
 	{
@@ -13,6 +13,7 @@
 #else
 #  include <fl/Headers.h>
 #endif
+#include "FuzzyKernel.h"
 #include "../Goals/CGoal.h"
 #include "../Pathfinding/AIPathfinder.h"
 
@@ -113,6 +114,10 @@ private:
 	fl::InputVariable * goldCostVariable;
 	fl::InputVariable * fearVariable;
 	fl::OutputVariable * value;
+	/// evaluates rules of engine without fuzzylite inference, null if rules can not be compiled
+	std::unique_ptr<FuzzyKernel> kernel;
+	/// if set, every kernel result is compared with result of fuzzylite
+	bool verifyKernel;
 	std::vector<std::shared_ptr<IEvaluationContextBuilder>> evaluationContextBuilders;
 
 	EvaluationContext buildEvaluationContext(Goals::TSubgoal goal) const;
@@ -28,7 +28,8 @@ namespace NKAI
 		scoutHeroTurnDistanceLimit(5),
 		maxGoldPreasure(0.3f), 
 		maxpass(30),
-		allowObjectGraph(false)
+		allowObjectGraph(false),
+		verifyFuzzyKernel(false)
 	{
 		ResourcePath resource("config/ai/nkai/nkai-settings", EResType::JSON);
 
@@ -80,5 +81,10 @@ namespace NKAI
 		{
 			allowObjectGraph = node.Struct()["allowObjectGraph"].Bool();
 		}
+
+		if(!node.Struct()["verifyFuzzyKernel"].isNull())
+		{
+			verifyFuzzyKernel = node.Struct()["verifyFuzzyKernel"].Bool();
+		}
 	}
 }
\ No newline at end of file
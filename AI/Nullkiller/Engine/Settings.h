@@ -27,6 +27,7 @@ namespace NKAI
 		int maxpass;
 		float maxGoldPreasure;
 		bool allowObjectGraph;
+		bool verifyFuzzyKernel;
 
 	public:
 		Settings();
@@ -37,6 +38,7 @@ namespace NKAI
 		int getMainHeroTurnDistanceLimit() const { return mainHeroTurnDistanceLimit; }
 		int getScoutHeroTurnDistanceLimit() const { return scoutHeroTurnDistanceLimit; }
 		bool isObjectGraphAllowed() const { return allowObjectGraph; }
+		bool isFuzzyKernelVerified() const { return verifyFuzzyKernel; }
 
 	private:
 		void loadFromMod(const std::string & modName, const ResourcePath & resource);
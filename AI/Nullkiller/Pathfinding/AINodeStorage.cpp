@@ -24,10 +24,9 @@
 namespace NKAI
 {
 
-std::shared_ptr<boost::multi_array<AIPathNode, 5>> AISharedStorage::shared;
-boost::mutex AISharedStorage::locker;
-std::set<int3> commitedTiles;
-std::set<int3> commitedTilesInitial;
+std::vector<std::unique_ptr<AISharedStorage::NodeArray>> AISharedStorage::pool;
+int AISharedStorage::storagesCount = 0;
+boost::mutex AISharedStorage::poolMutex;
 
 
 const uint64_t FirstActorMask = 1;
@@ -38,24 +37,62 @@ const uint64_t CHAIN_MAX_DEPTH = 4;
 const bool DO_NOT_SAVE_TO_COMMITED_TILES = false;
 
 AISharedStorage::AISharedStorage(int3 sizes)
+	: sizes(sizes)
 {
-	if(!shared){
-		shared.reset(new boost::multi_array<AIPathNode, 5>(
-			boost::extents[EPathfindingLayer::NUM_LAYERS][sizes.z][sizes.x][sizes.y][AIPathfinding::NUM_CHAINS]));
-	}
+	boost::lock_guard<boost::mutex> poolLock(poolMutex);
 
-	nodes = shared;
+	storagesCount++;
 }
 
 AISharedStorage::~AISharedStorage()
 {
-	nodes.reset();
-	if(shared && shared.use_count() == 1)
+	release();
+
+	boost::lock_guard<boost::mutex> poolLock(poolMutex);
+
+	// last AI is gone, free memory instead of keeping it till next game
+	if(--storagesCount == 0)
+		pool.clear();
+}
+
+void AISharedStorage::acquire()
+{
+	if(nodes)
+		return;
+
+	{
+		boost::lock_guard<boost::mutex> poolLock(poolMutex);
+
+		while(!pool.empty() && !nodes)
+		{
+			nodes = std::move(pool.back());
+			pool.pop_back();
+
+			const auto * shape = nodes->shape();
+
+			// array left from game on map of different size
+			if(int3(shape[2], shape[3], shape[1]) != sizes)
+				nodes.reset();
+		}
+	}
+
+	if(!nodes)
 	{
-		shared.reset();
+		nodes = std::make_unique<NodeArray>(
+			boost::extents[EPathfindingLayer::NUM_LAYERS][sizes.z][sizes.x][sizes.y][AIPathfinding::NUM_CHAINS]);
 	}
 }
 
+void AISharedStorage::release()
+{
+	if(!nodes)
+		return;
+
+	boost::lock_guard<boost::mutex> poolLock(poolMutex);
+
+	pool.push_back(std::move(nodes));
+}
+
 void AIPathNode::addSpecialAction(std::shared_ptr<const SpecialAction> action)
 {
 	if(!specialAction)
@@ -111,23 +148,23 @@ void AINodeStorage::initialize(const PathfinderOptions & options, const CGameSta
 			{
 				for(pos.y = 0; pos.y < sizes.y; ++pos.y)
 				{
-					const TerrainTile & tile = gs->map->getTile(pos);
-					if (!tile.terType->isPassable())
+					const ui8 tileFlags = gs->map->getTileFlags(pos);
+					if (!(tileFlags & ETileFlag::PASSABLE))
 						continue;
 
-					if (tile.terType->isWater())
+					if (tileFlags & ETileFlag::WATER)
 					{
-						resetTile(pos, ELayer::SAIL, PathfinderUtil::evaluateAccessibility<ELayer::SAIL>(pos, tile, fow, player, gs));
+						resetTile(pos, ELayer::SAIL, PathfinderUtil::evaluateAccessibility<ELayer::SAIL>(pos, tileFlags, fow, player, gs));
 						if (useFlying)
-							resetTile(pos, ELayer::AIR, PathfinderUtil::evaluateAccessibility<ELayer::AIR>(pos, tile, fow, player, gs));
+							resetTile(pos, ELayer::AIR, PathfinderUtil::evaluateAccessibility<ELayer::AIR>(pos, tileFlags, fow, player, gs));
 						if (useWaterWalking)
-							resetTile(pos, ELayer::WATER, PathfinderUtil::evaluateAccessibility<ELayer::WATER>(pos, tile, fow, player, gs));
+							resetTile(pos, ELayer::WATER, PathfinderUtil::evaluateAccessibility<ELayer::WATER>(pos, tileFlags, fow, player, gs));
 					}
 					else
 					{
-						resetTile(pos, ELayer::LAND, PathfinderUtil::evaluateAccessibility<ELayer::LAND>(pos, tile, fow, player, gs));
+						resetTile(pos, ELayer::LAND, PathfinderUtil::evaluateAccessibility<ELayer::LAND>(pos, tileFlags, fow, player, gs));
 						if (useFlying)
-							resetTile(pos, ELayer::AIR, PathfinderUtil::evaluateAccessibility<ELayer::AIR>(pos, tile, fow, player, gs));
+							resetTile(pos, ELayer::AIR, PathfinderUtil::evaluateAccessibility<ELayer::AIR>(pos, tileFlags, fow, player, gs));
 					}
 				}
 			}
@@ -1321,24 +1358,27 @@ std::vector<AIPath> AINodeStorage::getChainInfo(const int3 & pos, bool isOnLand)
 			continue;
 		}
 
-		AIPath path;
-
-		path.targetHero = node.actor->hero;
-		path.heroArmy = node.actor->creatureSet;
-		path.armyLoss = node.armyLoss;
-		path.targetObjectDanger = evaluateDanger(pos, path.targetHero, !node.actor->allowBattle);
-		path.targetObjectArmyLoss = evaluateArmyLoss(path.targetHero, path.heroArmy->getArmyStrength(), path.targetObjectDanger);
-		path.chainMask = node.actor->chainMask;
-		path.exchangeCount = node.actor->actorExchangeCount;
-		
-		fillChainInfo(&node, path, -1);
-
-		paths.push_back(path);
+		paths.push_back(AIPathView(this, &node).toPath());
 	}
 
 	return paths;
 }
 
+void AINodeStorage::getChainViews(const int3 & pos, bool isOnLand, std::vector<AIPathView> & views) const
+{
+	auto chains = nodes.get(pos, isOnLand ? EPathfindingLayer::LAND : EPathfindingLayer::SAIL);
+
+	for(const AIPathNode & node : chains)
+	{
+		if(node.action == EPathNodeAction::UNKNOWN || !node.actor || !node.actor->hero)
+		{
+			continue;
+		}
+
+		views.emplace_back(this, &node);
+	}
+}
+
 void AINodeStorage::fillChainInfo(const AIPathNode * node, AIPath & path, int parentIndex) const
 {
 	while(node != nullptr)
@@ -1380,6 +1420,68 @@ void AINodeStorage::fillChainInfo(const AIPathNode * node, AIPath & path, int pa
 	}
 }
 
+const AIPathNode & AIPathView::targetNode() const
+{
+	const AIPathNode * target = node;
+	int index = 0;
+
+	// AIPath::targetNode() takes first node of target hero or second node of path
+	storage->visitChain(node, [&](const AIPathNode * chainNode) -> bool
+	{
+		if(index == 1 || chainNode->actor->hero == node->actor->hero)
+		{
+			target = chainNode;
+			return false;
+		}
+
+		index++;
+		return true;
+	});
+
+	return *target;
+}
+
+uint64_t AIPathView::getHeroStrength() const
+{
+	return targetHero()->getFightingStrength() * heroArmy()->getArmyStrength();
+}
+
+bool AIPathView::hasBlockedAction() const
+{
+	bool blocked = false;
+
+	storage->visitChain(node, [&](const AIPathNode * chainNode) -> bool
+	{
+		if(chainNode->specialAction)
+		{
+			auto targetNode = chainNode->theNodeBefore ? storage->getAINode(chainNode->theNodeBefore) : chainNode;
+
+			blocked = !chainNode->specialAction->canAct(targetNode);
+		}
+
+		return !blocked;
+	});
+
+	return blocked;
+}
+
+AIPath AIPathView::toPath() const
+{
+	AIPath path;
+
+	path.targetHero = targetHero();
+	path.heroArmy = heroArmy();
+	path.armyLoss = node->armyLoss;
+	path.targetObjectDanger = storage->evaluateDanger(node->coord, path.targetHero, !node->actor->allowBattle);
+	path.targetObjectArmyLoss = storage->evaluateArmyLoss(path.targetHero, path.heroArmy->getArmyStrength(), path.targetObjectDanger);
+	path.chainMask = node->actor->chainMask;
+	path.exchangeCount = node->actor->actorExchangeCount;
+
+	storage->fillChainInfo(node, path, -1);
+
+	return path;
+}
+
 AIPath::AIPath()
 	: nodes({})
 {
@@ -116,6 +116,37 @@ struct AIPath
 	bool containsHero(const CGHeroInstance * hero) const;
 };
 
+class AINodeStorage;
+
+/// Path read in place from node storage, cheap enough to be created for every path of the map.
+/// Only values needed to filter paths are calculated, toPath() builds full AIPath once path is selected
+class AIPathView
+{
+	const AINodeStorage * storage;
+	const AIPathNode * node;
+
+public:
+	AIPathView(const AINodeStorage * storage, const AIPathNode * node)
+		:storage(storage), node(node)
+	{
+	}
+
+	const CGHeroInstance * targetHero() const { return node->actor->hero; }
+	const CCreatureSet * heroArmy() const { return node->actor->creatureSet; }
+
+	/// Same node as AIPath::targetNode()
+	const AIPathNode & targetNode() const;
+
+	float movementCost() const { return targetNode().getCost(); }
+	uint8_t turn() const { return targetNode().turns; }
+	uint64_t getHeroStrength() const;
+
+	/// Same as AIPath::getFirstBlockedAction() != nullptr
+	bool hasBlockedAction() const;
+
+	AIPath toPath() const;
+};
+
 struct ExchangeCandidate : public AIPathNode
 {
 	AIPathNode * carrierParent;
@@ -136,14 +167,24 @@ class AISharedStorage
 	// 1 - layer (air, water, land)
 	// 2-4 - position on map[z][x][y]
 	// 5 - chain (normal, battle, spellcast and combinations)
-	static std::shared_ptr<boost::multi_array<AIPathNode, 5>> shared;
-	std::shared_ptr<boost::multi_array<AIPathNode, 5>> nodes;
-public:
-	static boost::mutex locker;
+	using NodeArray = boost::multi_array<AIPathNode, 5>;
+
+	// node arrays are large, so AI which are not making turn return them to pool shared by all AI in the process
+	static std::vector<std::unique_ptr<NodeArray>> pool;
+	static int storagesCount;
+	static boost::mutex poolMutex;
 
+	int3 sizes;
+	std::unique_ptr<NodeArray> nodes;
+public:
 	AISharedStorage(int3 mapSize);
 	~AISharedStorage();
 
+	/// Takes node array from pool, allocates new one if all arrays are used by AI making turn at the same time
+	void acquire();
+	/// Returns node array to pool, nodes can't be accessed until acquired again
+	void release();
+
 	STRONG_INLINE
 	boost::detail::multi_array::sub_array<AIPathNode, 1> get(int3 tile, EPathfindingLayer layer) const
 	{
@@ -168,12 +209,18 @@ private:
 	int heroChainMaxTurns;
 	PlayerColor playerID;
 	uint8_t turnDistanceLimit[2];
+	mutable std::set<int3> commitedTiles; // filled by commit() of single-threaded passes only
+	std::set<int3> commitedTilesInitial;
 
 public:
 	/// more than 1 chain layer for each hero allows us to have more than 1 path to each tile so we can chose more optimal one.	
 	AINodeStorage(const Nullkiller * ai, const int3 & sizes);
 	~AINodeStorage();
 
+	/// Path nodes are only kept by AI while it is making turn, see AISharedStorage
+	void acquireNodes() { nodes.acquire(); }
+	void releaseNodes() { nodes.release(); }
+
 	void initialize(const PathfinderOptions & options, const CGameState * gs) override;
 
 	bool increaseHeroChainTurnLimit();
@@ -239,6 +286,7 @@ public:
 
 	std::optional<AIPathNode *> getOrCreateNode(const int3 & coord, const EPathfindingLayer layer, const ChainActor * actor);
 	std::vector<AIPath> getChainInfo(const int3 & pos, bool isOnLand) const;
+	void getChainViews(const int3 & pos, bool isOnLand, std::vector<AIPathView> & views) const;
 	bool isTileAccessible(const HeroPtr & hero, const int3 & pos, const EPathfindingLayer layer) const;
 	void setHeroes(std::map<const CGHeroInstance *, HeroRole> heroes);
 	void setScoutTurnDistanceLimit(uint8_t distanceLimit) { turnDistanceLimit[HeroRole::SCOUT] = distanceLimit; }
@@ -274,6 +322,27 @@ public:
 	void calculateTownPortalTeleportations(std::vector<CGPathNode *> & neighbours);
 	void fillChainInfo(const AIPathNode * node, AIPath & path, int parentIndex) const;
 
+	/// Visits nodes of chain in the same order as fillChainInfo adds them to path, stops once visitor returns false
+	template<typename Func>
+	bool visitChain(const AIPathNode * node, const Func & visitor) const
+	{
+		while(node != nullptr)
+		{
+			if(!node->actor->hero)
+				return true;
+
+			if(node->chainOther && !visitChain(node->chainOther, visitor))
+				return false;
+
+			if(!visitor(node))
+				return false;
+
+			node = getAINode(node->theNodeBefore);
+		}
+
+		return true;
+	}
+
 private:
 	template<class TVector>
 	void calculateTownPortal(
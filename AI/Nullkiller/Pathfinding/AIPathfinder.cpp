@@ -27,6 +27,12 @@ void AIPathfinder::init()
 	storage.reset();
 }
 
+void AIPathfinder::releaseNodes()
+{
+	if(storage)
+		storage->releaseNodes();
+}
+
 bool AIPathfinder::isTileAccessible(const HeroPtr & hero, const int3 & tile) const
 {
 	return storage->isTileAccessible(hero, tile, EPathfindingLayer::LAND)
@@ -58,6 +64,23 @@ std::vector<AIPath> AIPathfinder::getPathInfo(const int3 & tile, bool includeGra
 	return info;
 }
 
+const std::vector<AIPathView> & AIPathfinder::getPathViews(const int3 & tile) const
+{
+	// reused by all queries of the thread, so sweeps over the whole map do not allocate
+	thread_local std::vector<AIPathView> views;
+
+	views.clear();
+
+	const TerrainTile * tileInfo = cb->getTile(tile, false);
+
+	if(tileInfo)
+	{
+		storage->getChainViews(tile, !tileInfo->isWater(), views);
+	}
+
+	return views;
+}
+
 void AIPathfinder::updatePaths(const std::map<const CGHeroInstance *, HeroRole> & heroes, PathfinderSettings pathfinderSettings)
 {
 	if(!storage)
@@ -65,6 +88,8 @@ void AIPathfinder::updatePaths(const std::map<const CGHeroInstance *, HeroRole>
 		storage.reset(new AINodeStorage(ai, cb->getMapSize()));
 	}
 
+	storage->acquireNodes();
+
 	auto start = std::chrono::high_resolution_clock::now();
 	logAi->debug("Recalculate all paths");
 	int pass = 0;
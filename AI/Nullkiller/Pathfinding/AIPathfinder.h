@@ -45,10 +45,15 @@ private:
 public:
 	AIPathfinder(CPlayerSpecificInfoCallback * cb, Nullkiller * ai);
 	std::vector<AIPath> getPathInfo(const int3 & tile, bool includeGraph = false) const;
+	/// Views of paths to tile without copying path nodes, use AIPathView::toPath() for selected ones.
+	/// Result is per-thread buffer which is valid until next call from the same thread
+	const std::vector<AIPathView> & getPathViews(const int3 & tile) const;
 	bool isTileAccessible(const HeroPtr & hero, const int3 & tile) const;
 	void updatePaths(const std::map<const CGHeroInstance *, HeroRole> & heroes, PathfinderSettings pathfinderSettings);
 	void updateGraphs(const std::map<const CGHeroInstance *, HeroRole> & heroes);
 	void init();
+	/// Returns path nodes to pool once turn is over, paths can't be queried until next updatePaths
+	void releaseNodes();
 
 	std::shared_ptr<AINodeStorage>getStorage()
 	{
@@ -21,7 +21,7 @@
 #include "../../lib/mapObjects/CQuest.h"
 #include "../../lib/mapping/CMapDefines.h"
 
-extern FuzzyHelper * fh;
+extern thread_local FuzzyHelper * fh;
 
 const CGObjectInstance * ObjectIdRef::operator->() const
 {
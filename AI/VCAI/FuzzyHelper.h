@@ -52,4 +52,4 @@ public:
 	ui64 evaluateDanger(crint3 tile, const CGHeroInstance * visitor);
 };
 
-extern FuzzyHelper * fh;
+extern thread_local FuzzyHelper * fh;
@@ -17,8 +17,8 @@
 class AIPathfinder
 {
 private:
-	static std::vector<std::shared_ptr<AINodeStorage>> storagePool;
-	static std::map<HeroPtr, std::shared_ptr<AINodeStorage>> storageMap;
+	std::vector<std::shared_ptr<AINodeStorage>> storagePool;
+	std::map<HeroPtr, std::shared_ptr<AINodeStorage>> storageMap;
 	CPlayerSpecificInfoCallback * cb;
 	VCAI * ai;
 
@@ -34,13 +34,12 @@
 
 #include "AIhelper.h"
 
-extern FuzzyHelper * fh;
-
 const double SAFE_ATTACK_CONSTANT = 1.5;
 
 //one thread may be turn of AI and another will be handling a side effect for AI2
 thread_local CCallback * cb = nullptr;
 thread_local VCAI * ai = nullptr;
+thread_local FuzzyHelper * fh = nullptr;
 
 //std::map<int, std::map<int, int> > HeroView::infosCount;
 
@@ -54,6 +53,7 @@ struct SetGlobalState
 
 		ai = AI;
 		cb = AI->myCb.get();
+		fh = AI->fuzzyHelper.get();
 	}
 	~SetGlobalState()
 	{
@@ -61,6 +61,7 @@ struct SetGlobalState
 		//TODO: to ensure that, make rm unique_ptr
 		ai = nullptr;
 		cb = nullptr;
+		fh = nullptr;
 	}
 };
 
@@ -622,8 +623,9 @@ void VCAI::initGameInterface(std::shared_ptr<Environment> ENV, std::shared_ptr<C
 	myCb->waitTillRealize = true;
 	myCb->unlockGsWhenWaiting = true;
 
-	if(!fh)
-		fh = new FuzzyHelper();
+	// fuzzy engines keep state of evaluation, so each AI needs own helper to make turns simultaneously
+	fuzzyHelper = std::make_unique<FuzzyHelper>();
+	fh = fuzzyHelper.get();
 
 	retrieveVisitableObjs();
 }
@@ -33,6 +33,7 @@ struct QuestInfo;
 VCMI_LIB_NAMESPACE_END
 
 class AIhelper;
+class FuzzyHelper;
 
 class AIStatus
 {
@@ -122,6 +123,7 @@ public:
 	ObjectInstanceID selectedObject;
 
 	AIhelper * ah;
+	std::unique_ptr<FuzzyHelper> fuzzyHelper;
 
 	VCAI();
 	virtual ~VCAI();
@@ -0,0 +1,99 @@
+/*
+ * CBattleCallback.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "CCallback.h"
+
+#include "lib/UnlockGuard.h"
+#include "lib/battle/BattleAction.h"
+#include "lib/battle/IBattleState.h"
+#include "lib/gameState/CGameState.h"
+#include "lib/networkPacks/PacksForServer.h"
+
+CBattleCallback::CBattleCallback(std::optional<PlayerColor> player, ICallbackRequestHandler * requestHandler):
+	player(player),
+	requestHandler(requestHandler)
+{
+}
+
+void CBattleCallback::battleMakeSpellAction(const BattleID & battleID, const BattleAction & action)
+{
+	assert(action.actionType == EActionType::HERO_SPELL);
+	MakeAction mca(action);
+	mca.battleID = battleID;
+	sendRequest(&mca);
+}
+
+int CBattleCallback::sendRequest(const CPackForServer * request)
+{
+	int requestID = requestHandler->sendRequest(request, *getPlayerID());
+	if(waitTillRealize)
+	{
+		logGlobal->trace("We'll wait till request %d is answered.\n", requestID);
+		auto gsUnlocker = vstd::makeUnlockSharedGuardIf(CGameState::mutex, unlockGsWhenWaiting);
+		requestHandler->waitForRequest(requestID);
+	}
+
+	boost::this_thread::interruption_point();
+	return requestID;
+}
+
+void CBattleCallback::battleMakeUnitAction(const BattleID & battleID, const BattleAction & action)
+{
+	assert(!getBattle(battleID)->battleTacticDist());
+	MakeAction ma;
+	ma.ba = action;
+	ma.battleID = battleID;
+	sendRequest(&ma);
+}
+
+void CBattleCallback::battleMakeTacticAction(const BattleID & battleID, const BattleAction & action )
+{
+	assert(getBattle(battleID)->battleTacticDist());
+	MakeAction ma;
+	ma.ba = action;
+	ma.battleID = battleID;
+	sendRequest(&ma);
+}
+
+std::optional<BattleAction> CBattleCallback::makeSurrenderRetreatDecision(const BattleID & battleID, const BattleStateInfoForRetreat & battleState)
+{
+	return requestHandler->makeSurrenderRetreatDecision(getPlayerID().value(), battleID, battleState);
+}
+
+std::shared_ptr<CPlayerBattleCallback> CBattleCallback::getBattle(const BattleID & battleID)
+{
+	if (activeBattles.count(battleID))
+		return activeBattles.at(battleID);
+
+	throw std::runtime_error("Failed to find battle " + std::to_string(battleID.getNum()) + " of player " + player->toString() + ". Number of ongoing battles: " + std::to_string(activeBattles.size()));
+}
+
+std::optional<PlayerColor> CBattleCallback::getPlayerID() const
+{
+	return player;
+}
+
+void CBattleCallback::onBattleStarted(const IBattleInfo * info)
+{
+	if (activeBattles.count(info->getBattleID()) > 0)
+		throw std::runtime_error("Player " + player->toString() + " is already engaged in battle " + std::to_string(info->getBattleID().getNum()));
+
+	logGlobal->debug("Battle %d started for player %s", info->getBattleID(), player->toString());
+	activeBattles[info->getBattleID()] = std::make_shared<CPlayerBattleCallback>(info, *getPlayerID());
+}
+
+void CBattleCallback::onBattleEnded(const BattleID & battleID)
+{
+	if (activeBattles.count(battleID) == 0)
+		throw std::runtime_error("Player " + player->toString() + " is not engaged in battle " + std::to_string(battleID.getNum()));
+
+	logGlobal->debug("Battle %d ended for player %s", battleID, player->toString());
+	activeBattles.erase(battleID);
+}
@@ -14,6 +14,7 @@
 #include "lib/gameState/CGameState.h"
 #include "client/CPlayerInterface.h"
 #include "client/Client.h"
+#include "client/GameBenchmark.h"
 #include "lib/mapping/CMap.h"
 #include "lib/mapObjects/CGHeroInstance.h"
 #include "lib/mapObjects/CGTownInstance.h"
@@ -207,28 +208,6 @@ bool CCallback::buildBuilding(const CGTownInstance *town, BuildingID buildingID)
 	return true;
 }
 
-void CBattleCallback::battleMakeSpellAction(const BattleID & battleID, const BattleAction & action)
-{
-	assert(action.actionType == EActionType::HERO_SPELL);
-	MakeAction mca(action);
-	mca.battleID = battleID;
-	sendRequest(&mca);
-}
-
-int CBattleCallback::sendRequest(const CPackForServer * request)
-{
-	int requestID = cl->sendRequest(request, *getPlayerID());
-	if(waitTillRealize)
-	{
-		logGlobal->trace("We'll wait till request %d is answered.\n", requestID);
-		auto gsUnlocker = vstd::makeUnlockSharedGuardIf(CGameState::mutex, unlockGsWhenWaiting);
-		CClient::waitingRequest.waitWhileContains(requestID);
-	}
-
-	boost::this_thread::interruption_point();
-	return requestID;
-}
-
 void CCallback::swapGarrisonHero( const CGTownInstance *town )
 {
 	if(town->tempOwner == *player || (town->garrisonHero && town->garrisonHero->tempOwner == *player ))
@@ -316,6 +295,7 @@ void CCallback::buildBoat( const IShipyard *obj )
 
 CCallback::CCallback(CGameState * GS, std::optional<PlayerColor> Player, CClient * C)
 	: CBattleCallback(Player, C)
+	, cl(C)
 {
 	gs = GS;
 
@@ -336,6 +316,18 @@ std::shared_ptr<const CPathsInfo> CCallback::getPathsInfo(const CGHeroInstance *
 	return cl->getPathsInfo(h);
 }
 
+void CCallback::calculatePaths(const std::shared_ptr<PathfinderConfig> & config)
+{
+	GameBenchmark::PathfindingScope benchmarkScope(cl->benchmark.get());
+	CPlayerSpecificInfoCallback::calculatePaths(config);
+}
+
+void CCallback::calculatePaths(const CGHeroInstance * hero, CPathsInfo & out)
+{
+	GameBenchmark::PathfindingScope benchmarkScope(cl->benchmark.get());
+	CPlayerSpecificInfoCallback::calculatePaths(hero, out);
+}
+
 std::optional<PlayerColor> CCallback::getPlayerID() const
 {
 	return CBattleCallback::getPlayerID();
@@ -382,63 +374,3 @@ void CCallback::unregisterBattleInterface(std::shared_ptr<IBattleEventsReceiver>
 {
 	cl->additionalBattleInts[*player] -= battleEvents;
 }
-
-CBattleCallback::CBattleCallback(std::optional<PlayerColor> player, CClient * C):
-	cl(C),
-	player(player)
-{
-}
-
-void CBattleCallback::battleMakeUnitAction(const BattleID & battleID, const BattleAction & action)
-{
-	assert(!cl->gs->getBattle(battleID)->tacticDistance);
-	MakeAction ma;
-	ma.ba = action;
-	ma.battleID = battleID;
-	sendRequest(&ma);
-}
-
-void CBattleCallback::battleMakeTacticAction(const BattleID & battleID, const BattleAction & action )
-{
-	assert(cl->gs->getBattle(battleID)->tacticDistance);
-	MakeAction ma;
-	ma.ba = action;
-	ma.battleID = battleID;
-	sendRequest(&ma);
-}
-
-std::optional<BattleAction> CBattleCallback::makeSurrenderRetreatDecision(const BattleID & battleID, const BattleStateInfoForRetreat & battleState)
-{
-	return cl->playerint[getPlayerID().value()]->makeSurrenderRetreatDecision(battleID, battleState);
-}
-
-std::shared_ptr<CPlayerBattleCallback> CBattleCallback::getBattle(const BattleID & battleID)
-{
-	if (activeBattles.count(battleID))
-		return activeBattles.at(battleID);
-
-	throw std::runtime_error("Failed to find battle " + std::to_string(battleID.getNum()) + " of player " + player->toString() + ". Number of ongoing battles: " + std::to_string(activeBattles.size()));
-}
-
-std::optional<PlayerColor> CBattleCallback::getPlayerID() const
-{
-	return player;
-}
-
-void CBattleCallback::onBattleStarted(const IBattleInfo * info)
-{
-	if (activeBattles.count(info->getBattleID()) > 0)
-		throw std::runtime_error("Player " + player->toString() + " is already engaged in battle " + std::to_string(info->getBattleID().getNum()));
-
-	logGlobal->debug("Battle %d started for player %s", info->getBattleID(), player->toString());
-	activeBattles[info->getBattleID()] = std::make_shared<CPlayerBattleCallback>(info, *getPlayerID());
-}
-
-void CBattleCallback::onBattleEnded(const BattleID & battleID)
-{
-	if (activeBattles.count(battleID) == 0)
-		throw std::runtime_error("Player " + player->toString() + " is not engaged in battle " + std::to_string(battleID.getNum()));
-
-	logGlobal->debug("Battle %d ended for player %s", battleID, player->toString());
-	activeBattles.erase(battleID);
-}
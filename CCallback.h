@@ -114,18 +114,30 @@ public:
 	virtual void bulkMoveArtifacts(ObjectInstanceID srcHero, ObjectInstanceID dstHero, bool swap, bool equipped, bool backpack) = 0;
 };
 
+/// Delivers requests made through player callbacks. Client sends them to server,
+/// tools that play battles without client (battle simulator) handle them directly
+class ICallbackRequestHandler
+{
+public:
+	virtual ~ICallbackRequestHandler() = default;
+
+	virtual int sendRequest(const CPackForServer * request, PlayerColor player) = 0; //returns ID given to that request
+	virtual void waitForRequest(int requestID) = 0; //blocks until request is answered by server
+	virtual std::optional<BattleAction> makeSurrenderRetreatDecision(PlayerColor player, const BattleID & battleID, const BattleStateInfoForRetreat & battleState) = 0;
+};
+
 class CBattleCallback : public IBattleCallback
 {
 	std::map<BattleID, std::shared_ptr<CPlayerBattleCallback>> activeBattles;
 
 	std::optional<PlayerColor> player;
+	ICallbackRequestHandler * requestHandler;
 
 protected:
 	int sendRequest(const CPackForServer * request); //returns requestID (that'll be matched to requestID in PackageApplied)
-	CClient *cl;
 
 public:
-	CBattleCallback(std::optional<PlayerColor> player, CClient * C);
+	CBattleCallback(std::optional<PlayerColor> player, ICallbackRequestHandler * requestHandler);
 	void battleMakeSpellAction(const BattleID & battleID, const BattleAction & action) override;//for casting spells by hero - DO NOT use it for moving active stack
 	void battleMakeUnitAction(const BattleID & battleID, const BattleAction & action) override;
 	void battleMakeTacticAction(const BattleID & battleID, const BattleAction & action) override; // performs tactic phase actions
@@ -143,6 +155,8 @@ public:
 
 class CCallback : public CPlayerSpecificInfoCallback, public CBattleCallback, public IGameActionCallback
 {
+	CClient * cl;
+
 public:
 	CCallback(CGameState * GS, std::optional<PlayerColor> Player, CClient * C);
 	virtual ~CCallback();
@@ -151,6 +165,8 @@ public:
 	virtual bool canMoveBetween(const int3 &a, const int3 &b);
 	virtual int3 getGuardingCreaturePosition(int3 tile);
 	virtual std::shared_ptr<const CPathsInfo> getPathsInfo(const CGHeroInstance * h);
+	void calculatePaths(const std::shared_ptr<PathfinderConfig> & config) override;
+	void calculatePaths(const CGHeroInstance * hero, CPathsInfo & out) override;
 
 	std::optional<PlayerColor> getPlayerID() const override;
 
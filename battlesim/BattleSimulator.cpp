@@ -0,0 +1,304 @@
+/*
+ * BattleSimulator.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "BattleSimulator.h"
+
+#include "SimulatorRequestHandler.h"
+
+#include "../server/CGameHandler.h"
+#include "../server/battles/BattleProcessor.h"
+
+#include "../lib/CGameInterface.h"
+#include "../lib/CPlayerState.h"
+#include "../lib/CStack.h"
+#include "../lib/json/JsonNode.h"
+#include "../lib/StartInfo.h"
+#include "../lib/battle/AutocombatPreferences.h"
+#include "../lib/battle/BattleInfo.h"
+#include "../lib/gameState/CGameState.h"
+#include "../lib/LoadProgress.h"
+#include "../lib/mapObjects/CArmedInstance.h"
+#include "../lib/mapping/CMap.h"
+#include "../lib/mapping/CMapHeader.h"
+#include "../lib/mapping/CMapService.h"
+#include "../lib/networkPacks/PacksForClient.h"
+
+/// Failsafe against AI that can not finish battle, e.g. two armies of stacks that can not damage each other
+static constexpr int MAX_ACTIONS_PER_BATTLE = 10000;
+
+BattleSimulator::BattleSimulator(const BattleSimulatorOptions & options)
+	: options(options)
+{
+}
+
+BattleSimulator::~BattleSimulator() = default;
+
+void BattleSimulator::loadScenarios(const JsonNode & config)
+{
+	for(const auto & scenarioNode : config["scenarios"].Vector())
+	{
+		BattleSimulatorScenario scenario;
+		scenario.name = scenarioNode["name"].String();
+
+		for(int side : {0, 1})
+		{
+			const auto & armyNode = scenarioNode[side == 0 ? "attacker" : "defender"];
+
+			for(const auto & stackNode : armyNode.Vector())
+			{
+				CreatureID creature(CreatureID::decode(stackNode["type"].String()));
+				int amount = static_cast<int>(stackNode["amount"].Integer());
+
+				if(creature == CreatureID::NONE || amount <= 0)
+					throw std::runtime_error("Invalid stack in scenario '" + scenario.name + "'!");
+
+				scenario.armies[side].emplace_back(creature, amount);
+			}
+
+			if(scenario.armies[side].empty() || scenario.armies[side].size() > GameConstants::ARMY_SIZE)
+				throw std::runtime_error("Invalid army size in scenario '" + scenario.name + "'!");
+		}
+
+		scenarios.push_back(scenario);
+	}
+}
+
+void BattleSimulator::startGame()
+{
+	StartInfo si;
+	si.mapname = options.mapName;
+	si.mode = EStartMode::NEW_GAME;
+	si.seedToBeUsed = options.seed;
+
+	CMapService mapService;
+	auto header = mapService.loadMapHeader(ResourcePath(si.mapname, EResType::MAP));
+
+	for(int i = 0; i < header->players.size(); i++)
+	{
+		const PlayerInfo & pinfo = header->players[i];
+
+		if (!(pinfo.canHumanPlay || pinfo.canComputerPlay))
+			continue;
+
+		// no connected players - all players are controlled by AI
+		PlayerSettings & pset = si.playerInfos[PlayerColor(i)];
+		pset.color = PlayerColor(i);
+		pset.name = "AI";
+		pset.castle = pinfo.defaultCastle();
+		pset.hero = pinfo.defaultHero();
+		pset.handicap = PlayerSettings::NO_HANDICAP;
+	}
+
+	if(si.playerInfos.empty())
+		throw std::runtime_error("Map " + options.mapName + " has no players!");
+
+	Load::ProgressAccumulator progressTracking;
+	gameHandler = std::make_unique<CGameHandler>(nullptr);
+	gameHandler->init(&si, progressTracking);
+
+	attackerPlayer = gameHandler->gameState()->players.begin()->first;
+}
+
+int3 BattleSimulator::findFreeTile() const
+{
+	const auto * map = gameHandler->gameState()->map.get();
+
+	for(int x = 0; x < map->width; ++x)
+	{
+		for(int y = 0; y < map->height; ++y)
+		{
+			const TerrainTile & tile = map->getTile(int3(x, y, 0));
+
+			if(tile.isClear() && !tile.isWater())
+				return int3(x, y, 0);
+		}
+	}
+	throw std::runtime_error("Failed to find free tile to place army!");
+}
+
+const CArmedInstance * BattleSimulator::createArmy(const std::vector<std::pair<CreatureID, int>> & stacks, const PlayerColor & owner, const int3 & position)
+{
+	NewObject no;
+	no.ID = Obj::MONSTER;
+	no.subID = stacks.front().first.getNum();
+	no.targetPos = position;
+	no.initiator = PlayerColor::NEUTRAL;
+	gameHandler->sendAndApply(&no);
+
+	auto * army = dynamic_cast<CArmedInstance *>(gameHandler->gameState()->map->objects.at(no.createdObjectID.getNum()).get());
+	if(!army)
+		throw std::runtime_error("Failed to create army!");
+
+	// There are no clients that need to know about this, so modify object directly instead of sending packs
+	army->tempOwner = owner;
+	army->eraseStack(SlotID(0));
+	for(int i = 0; i < stacks.size(); ++i)
+		army->putStack(SlotID(i), new CStackInstance(stacks[i].first, stacks[i].second));
+
+	return army;
+}
+
+void BattleSimulator::removeArmy(const CArmedInstance * army)
+{
+	gameHandler->removeObject(army, PlayerColor::NEUTRAL);
+}
+
+void BattleSimulator::simulateBattle(const BattleSimulatorScenario & scenario, BattleSimulatorStats & stats)
+{
+	// armies block their tiles, so second search will find another tile
+	const int3 attackerPosition = findFreeTile();
+	const CArmedInstance * attackerArmy = createArmy(scenario.armies[0], attackerPlayer, attackerPosition);
+	const int3 defenderPosition = findFreeTile();
+	const CArmedInstance * defenderArmy = createArmy(scenario.armies[1], PlayerColor::NEUTRAL, defenderPosition);
+
+	const ObjectInstanceID armyIDs[2] = { attackerArmy->id, defenderArmy->id };
+
+	gameHandler->battles->startBattlePrimary(attackerArmy, defenderArmy, defenderPosition, nullptr, nullptr, false, nullptr);
+
+	const BattleInfo * battle = gameHandler->gameState()->getBattle(attackerPlayer);
+	if(!battle)
+		throw std::runtime_error("Failed to start battle in scenario '" + scenario.name + "'!");
+
+	const BattleID battleID = battle->getBattleID();
+
+	// CGameHandler is also environment for server-side scripts, so reuse it for AI
+	std::shared_ptr<Environment> env(gameHandler.get(), [](Environment *){});
+	SimulatorRequestHandler requestHandlers[2];
+	std::shared_ptr<CBattleCallback> callbacks[2];
+	std::shared_ptr<CBattleGameInterface> ais[2];
+
+	for(int side : {0, 1})
+	{
+		callbacks[side] = std::make_shared<CBattleCallback>(battle->getSidePlayer(side), &requestHandlers[side]);
+		callbacks[side]->onBattleStarted(battle);
+
+		ais[side] = CDynLibHandler::getNewBattleAI(side == 0 ? options.attackerAI : options.defenderAI);
+		ais[side]->initBattleInterface(env, callbacks[side], AutocombatPreferences());
+		ais[side]->battleStart(battleID, attackerArmy, defenderArmy, defenderPosition, nullptr, nullptr, side, false);
+	}
+
+	auto battleStart = std::chrono::steady_clock::now();
+
+	for(int actionsMade = 0;; ++actionsMade)
+	{
+		// battle is removed from game state once all results have been applied
+		battle = gameHandler->gameState()->getBattle(battleID);
+		if(!battle)
+			break;
+
+		if(actionsMade >= MAX_ACTIONS_PER_BATTLE)
+			throw std::runtime_error("Battle in scenario '" + scenario.name + "' did not finish in time!");
+
+		const bool tacticPhase = battle->tacticDistance != 0;
+		const CStack * activeStack = tacticPhase ? nullptr : battle->battleGetStackByID(battle->getActiveStackID());
+		const int side = tacticPhase ? battle->tacticsSide : activeStack->unitSide();
+		const PlayerColor player = battle->getSidePlayer(side);
+
+		auto decisionStart = std::chrono::steady_clock::now();
+
+		if(tacticPhase)
+			ais[side]->yourTacticPhase(battleID, battle->tacticDistance);
+		else
+			ais[side]->activeStack(battleID, activeStack);
+
+		decisionTimes.push_back(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - decisionStart).count());
+
+		auto action = requestHandlers[side].takeAction();
+		if(!action)
+		{
+			logGlobal->error("AI of side %d made no action in scenario '%s'", side, scenario.name);
+			action = tacticPhase ? BattleAction::makeEndOFTacticPhase(side) : BattleAction::makeDefend(activeStack);
+		}
+
+		gameHandler->battles->makePlayerBattleAction(battleID, player, *action);
+		stats.actions++;
+	}
+
+	stats.timeSpentUs += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - battleStart).count();
+	stats.battles++;
+
+	bool survived[2];
+	for(int side : {0, 1})
+	{
+		const auto * army = dynamic_cast<const CArmedInstance *>(gameHandler->getObj(armyIDs[side], false));
+		survived[side] = army && army->stacksCount() > 0;
+
+		if(army)
+			removeArmy(army);
+	}
+
+	if(survived[0] == survived[1])
+		stats.draws++;
+	else
+		stats.wins[survived[0] ? 0 : 1]++;
+}
+
+void BattleSimulator::run()
+{
+	startGame();
+
+	scenarioStats.resize(scenarios.size());
+
+	for(int i = 0; i < scenarios.size(); ++i)
+	{
+		logGlobal->info("Simulating scenario '%s'", scenarios[i].name);
+
+		for(int battle = 0; battle < options.battlesPerScenario; ++battle)
+			simulateBattle(scenarios[i], scenarioStats[i]);
+	}
+}
+
+void BattleSimulator::printReport(std::ostream & out) const
+{
+	BattleSimulatorStats total;
+
+	for(int i = 0; i < scenarios.size(); ++i)
+	{
+		const auto & stats = scenarioStats.at(i);
+
+		out << boost::format("%s: %d battles, attacker won %d, defender won %d, draws %d, %.1f actions per battle\n")
+			% scenarios[i].name
+			% stats.battles
+			% stats.wins[0]
+			% stats.wins[1]
+			% stats.draws
+			% (stats.battles ? static_cast<double>(stats.actions) / stats.battles : 0.0);
+
+		total.battles += stats.battles;
+		total.actions += stats.actions;
+		total.timeSpentUs += stats.timeSpentUs;
+	}
+
+	const double seconds = total.timeSpentUs / 1000000.0;
+
+	out << boost::format("Total: %d battles, %d actions in %.2f s (%.2f battles/s, %.1f actions/s)\n")
+		% total.battles
+		% total.actions
+		% seconds
+		% (seconds > 0 ? total.battles / seconds : 0.0)
+		% (seconds > 0 ? total.actions / seconds : 0.0);
+
+	if(decisionTimes.empty())
+		return;
+
+	auto sortedTimes = decisionTimes;
+	std::sort(sortedTimes.begin(), sortedTimes.end());
+
+	auto percentile = [&sortedTimes](double value) -> int64_t
+	{
+		return sortedTimes.at(static_cast<size_t>(value * (sortedTimes.size() - 1)));
+	};
+
+	out << boost::format("AI decision time (us): p50 %d, p90 %d, p99 %d, max %d\n")
+		% percentile(0.5)
+		% percentile(0.9)
+		% percentile(0.99)
+		% sortedTimes.back();
+}
@@ -0,0 +1,75 @@
+/*
+ * BattleSimulator.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include "../lib/constants/EntityIdentifiers.h"
+#include "../lib/int3.h"
+
+VCMI_LIB_NAMESPACE_BEGIN
+class CArmedInstance;
+class JsonNode;
+VCMI_LIB_NAMESPACE_END
+
+class CGameHandler;
+
+struct BattleSimulatorOptions
+{
+	/// Map on which all battles take place. Only used to provide terrain and players, must have at least one player
+	std::string mapName;
+	std::string attackerAI;
+	std::string defenderAI;
+	/// Number of battles to run for each scenario
+	int battlesPerScenario = 1;
+	uint32_t seed = 0;
+};
+
+struct BattleSimulatorScenario
+{
+	std::string name;
+	std::vector<std::pair<CreatureID, int>> armies[2];
+};
+
+struct BattleSimulatorStats
+{
+	int battles = 0;
+	int wins[2] = {0, 0};
+	int draws = 0;
+	int64_t actions = 0;
+	int64_t timeSpentUs = 0;
+};
+
+/// Runs battles between AI's on server side without any clients or network connections
+class BattleSimulator
+{
+	BattleSimulatorOptions options;
+	std::vector<BattleSimulatorScenario> scenarios;
+
+	std::unique_ptr<CGameHandler> gameHandler;
+	PlayerColor attackerPlayer;
+
+	/// time taken by AI to select single action, in microseconds
+	std::vector<int64_t> decisionTimes;
+	std::vector<BattleSimulatorStats> scenarioStats;
+
+	void startGame();
+	int3 findFreeTile() const;
+	const CArmedInstance * createArmy(const std::vector<std::pair<CreatureID, int>> & stacks, const PlayerColor & owner, const int3 & position);
+	void removeArmy(const CArmedInstance * army);
+
+	void simulateBattle(const BattleSimulatorScenario & scenario, BattleSimulatorStats & stats);
+
+public:
+	explicit BattleSimulator(const BattleSimulatorOptions & options);
+	~BattleSimulator();
+
+	void loadScenarios(const JsonNode & config);
+	void run();
+	void printReport(std::ostream & out) const;
+};
@@ -0,0 +1,115 @@
+/*
+ * EntryPoint.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+
+#include "BattleSimulator.h"
+
+#include "../lib/CConfigHandler.h"
+#include "../lib/CConsoleHandler.h"
+#include "../lib/GameConstants.h"
+#include "../lib/logging/CBasicLogConfigurator.h"
+#include "../lib/json/JsonNode.h"
+#include "../lib/VCMIDirs.h"
+#include "../lib/VCMI_Lib.h"
+
+#include <boost/program_options.hpp>
+
+static void handleCommandOptions(int argc, const char * argv[], boost::program_options::variables_map & options)
+{
+	boost::program_options::options_description opts("Allowed options");
+	opts.add_options()
+	("help,h", "display help and exit")
+	("version,v", "display version information and exit")
+	("scenarios", boost::program_options::value<std::string>(), "path to json file with armies that should fight each other")
+	("map", boost::program_options::value<std::string>()->default_value("Maps/Arrogance"), "map that provides terrain and players for battles")
+	("battles", boost::program_options::value<int>()->default_value(10), "number of battles to run for each scenario")
+	("attacker-ai", boost::program_options::value<std::string>(), "battle AI used by attacking army, friendlyAI from settings by default")
+	("defender-ai", boost::program_options::value<std::string>(), "battle AI used by defending army, neutralAI from settings by default")
+	("seed", boost::program_options::value<uint32_t>()->default_value(0), "random seed, 0 to use current time");
+
+	try
+	{
+		boost::program_options::store(boost::program_options::parse_command_line(argc, argv, opts), options);
+	}
+	catch(boost::program_options::error & e)
+	{
+		std::cerr << "Failure during parsing command-line options:\n" << e.what() << std::endl;
+	}
+
+	boost::program_options::notify(options);
+
+	if(options.count("help") || !options.count("scenarios"))
+	{
+		printf("%s - headless battle simulator\n", GameConstants::VCMI_VERSION.c_str());
+		printf("\n");
+		std::cout << opts;
+		exit(0);
+	}
+
+	if(options.count("version"))
+	{
+		printf("%s\n", GameConstants::VCMI_VERSION.c_str());
+		std::cout << VCMIDirs::get().genHelpString();
+		exit(0);
+	}
+}
+
+static JsonNode loadScenarios(const std::string & path)
+{
+	std::ifstream file(path, std::ios::binary);
+	if(!file)
+		throw std::runtime_error("Failed to open scenarios file " + path);
+
+	std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	return JsonNode(reinterpret_cast<const std::byte *>(data.data()), data.size());
+}
+
+int main(int argc, const char * argv[])
+{
+	console = new CConsoleHandler();
+	CBasicLogConfigurator logConfig(VCMIDirs::get().userLogsPath() / "VCMI_BattleSim_log.txt", console);
+	logConfig.configureDefault();
+
+	boost::program_options::variables_map opts;
+	handleCommandOptions(argc, argv, opts);
+	preinitDLL(console, false);
+	logConfig.configure();
+
+	loadDLLClasses();
+
+	int exitCode = 0;
+
+	try
+	{
+		BattleSimulatorOptions options;
+		options.mapName = opts["map"].as<std::string>();
+		options.battlesPerScenario = opts["battles"].as<int>();
+		options.seed = opts["seed"].as<uint32_t>();
+		options.attackerAI = opts.count("attacker-ai") ? opts["attacker-ai"].as<std::string>() : settings["server"]["friendlyAI"].String();
+		options.defenderAI = opts.count("defender-ai") ? opts["defender-ai"].as<std::string>() : settings["server"]["neutralAI"].String();
+
+		BattleSimulator simulator(options);
+		simulator.loadScenarios(loadScenarios(opts["scenarios"].as<std::string>()));
+		simulator.run();
+		simulator.printReport(std::cout);
+
+		// BattleSimulator destructor must be called here - before VLC cleanup
+	}
+	catch(const std::exception & e)
+	{
+		logGlobal->error("Battle simulation failed: %s", e.what());
+		exitCode = 1;
+	}
+
+	logConfig.deconfigure();
+	vstd::clear_pointer(VLC);
+
+	return exitCode;
+}
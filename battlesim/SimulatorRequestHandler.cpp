@@ -0,0 +1,42 @@
+/*
+ * SimulatorRequestHandler.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "SimulatorRequestHandler.h"
+
+#include "../lib/networkPacks/PacksForServer.h"
+
+int SimulatorRequestHandler::sendRequest(const CPackForServer * request, PlayerColor player)
+{
+	const auto * makeAction = dynamic_cast<const MakeAction *>(request);
+
+	if(!makeAction)
+		throw std::runtime_error("Battle simulator can not send requests to server!");
+
+	pendingAction = makeAction->ba;
+	return ++requestsCount;
+}
+
+void SimulatorRequestHandler::waitForRequest(int requestID)
+{
+	// actions are applied by simulator after AI has returned, there is nothing to wait for
+}
+
+std::optional<BattleAction> SimulatorRequestHandler::makeSurrenderRetreatDecision(PlayerColor player, const BattleID & battleID, const BattleStateInfoForRetreat & battleState)
+{
+	// there are no adventure map interfaces in simulator, so fight till the end
+	return std::nullopt;
+}
+
+std::optional<BattleAction> SimulatorRequestHandler::takeAction()
+{
+	auto result = pendingAction;
+	pendingAction.reset();
+	return result;
+}
@@ -0,0 +1,29 @@
+/*
+ * SimulatorRequestHandler.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include "../CCallback.h"
+#include "../lib/battle/BattleAction.h"
+
+/// Handles requests of battle AI's in simulator
+/// Instead of sending requests to server actions are stored and later fed directly into battle processor
+class SimulatorRequestHandler : public ICallbackRequestHandler
+{
+	std::optional<BattleAction> pendingAction;
+	int requestsCount = 0;
+
+public:
+	int sendRequest(const CPackForServer * request, PlayerColor player) override;
+	void waitForRequest(int requestID) override;
+	std::optional<BattleAction> makeSurrenderRetreatDecision(PlayerColor player, const BattleID & battleID, const BattleStateInfoForRetreat & battleState) override;
+
+	/// Returns action selected by AI since last call, if any
+	std::optional<BattleAction> takeAction();
+};
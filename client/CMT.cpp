@@ -22,11 +22,14 @@
 #include "gui/CGuiHandler.h"
 #include "gui/WindowHandler.h"
 #include "CServerHandler.h"
+#include "Client.h"
+#include "GameBenchmark.h"
 #include "ClientCommandManager.h"
 #include "windows/CMessage.h"
 #include "windows/InfoWindows.h"
 #include "render/IScreenHandler.h"
 #include "render/Graphics.h"
+#include "render/IRenderHandler.h"
 
 #include "../lib/CConfigHandler.h"
 #include "../lib/CGeneralTextHandler.h"
@@ -63,6 +66,8 @@ void processCommand(const std::string &message);
 void playIntro();
 [[noreturn]] static void quitApplication();
 static void mainLoop();
+static void prefetchMainMenuAnimations();
+static bool reportFinishedBenchmark();
 
 static CBasicLogConfigurator *logConfig;
 
@@ -134,6 +139,8 @@ int main(int argc, char * argv[])
 		("headless", "runs without GUI, implies --onlyAI")
 		("ai", po::value<std::vector<std::string>>(), "AI to be used for the player, can be specified several times for the consecutive players")
 		("oneGoodAI", "puts one default AI and the rest will be EmptyAI")
+		("benchmark-days", po::value<si64>(), "plays given number of days of AI-only game on --testmap without GUI, then prints performance report and exits")
+		("seed", po::value<si64>(), "random seed of game started with --testmap")
 		("autoSkip", "automatically skip turns in GUI")
 		("disable-video", "disable video player")
 		("nointro,i", "skips intro movies")
@@ -218,7 +225,13 @@ int main(int argc, char * argv[])
 	};
 
 	setSettingBool("session/onlyai", "onlyAI");
-	if(vm.count("headless"))
+	if(vm.count("benchmark-days"))
+	{
+		session["benchmarkDays"].Integer() = vm["benchmark-days"].as<si64>();
+		session["headless"].Bool() = true;
+		session["onlyai"].Bool() = true;
+	}
+	else if(vm.count("headless"))
 	{
 		session["headless"].Bool() = true;
 		session["onlyai"].Bool() = true;
@@ -234,6 +247,15 @@ int main(int argc, char * argv[])
 		if(vm.count("spectate-battle-speed"))
 			session["spectate-battle-speed"].Float() = vm["spectate-battle-speed"].as<int>();
 	}
+	if(vm.count("ai"))
+	{
+		session["ai"].Vector().clear();
+		for(const auto & ai : vm["ai"].as<std::vector<std::string>>())
+			session["ai"].Vector().emplace_back(ai);
+	}
+	if(vm.count("seed"))
+		session["seed"].Integer() = vm["seed"].as<si64>();
+
 	// Server settings
 	setSettingBool("session/donotstartserver", "donotstartserver");
 
@@ -329,6 +351,7 @@ int main(int argc, char * argv[])
 	{
 		pomtime.getDiff();
 		graphics = new Graphics(); // should be before curh
+		prefetchMainMenuAnimations();
 
 		CCS->curh = new CursorHandler();
 		logGlobal->info("Screen handler: %d ms", pomtime.getDiff());
@@ -372,12 +395,45 @@ int main(int argc, char * argv[])
 	else
 	{
 		while(true)
+		{
 			boost::this_thread::sleep_for(boost::chrono::milliseconds(200));
+
+			if(reportFinishedBenchmark())
+				handleQuit(false);
+		}
 	}
 
 	return 0;
 }
 
+/// Buttons of first screen of main menu are decoded in background while rest of client is initialized
+static void prefetchMainMenuAnimations()
+{
+	const JsonNode & menuItems = CMainMenuConfig::get().getConfig()["window"]["items"];
+
+	if(menuItems.Vector().empty())
+		return;
+
+	std::vector<AnimationPath> paths;
+	for(const JsonNode & button : menuItems.Vector().front()["buttons"].Vector())
+		paths.push_back(AnimationPath::fromJson(button["name"]));
+
+	GH.renderHandler().prefetchAnimations(paths);
+}
+
+/// Benchmark is finished by packs applied on network thread, but client can only be shut down from main thread
+static bool reportFinishedBenchmark()
+{
+	boost::mutex::scoped_lock interfaceLock(GH.interfaceMutex);
+
+	if(!CSH->client || !CSH->client->benchmark || !CSH->client->benchmark->isFinished())
+		return false;
+
+	CSH->client->benchmark->printReport(std::cout);
+	CSH->client->benchmark->saveReport(VCMIDirs::get().userLogsPath() / "VCMI_Benchmark.json");
+	return true;
+}
+
 //plays intro, ends when intro is over or button has been pressed (handles events)
 void playIntro()
 {
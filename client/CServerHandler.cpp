@@ -11,6 +11,7 @@
 
 #include "CServerHandler.h"
 #include "Client.h"
+#include "GameBenchmark.h"
 #include "CGameInfo.h"
 #include "ServerRunner.h"
 #include "GameChatHandler.h"
@@ -207,6 +208,8 @@ void CServerHandler::startLocalServerAndConnect(bool connectToLobby)
 
 	auto lastDifficulty = settings["general"]["lastDifficulty"];
 	si->difficulty = lastDifficulty.Integer();
+	// only server running as thread of client uses this start info, e.g. for reproducible benchmarks
+	si->seedToBeUsed = static_cast<ui32>(settings["session"]["seed"].Integer());
 
 	logNetwork->trace("\tStarting local server");
 	serverRunner->start(getLocalPort(), connectToLobby, si);
@@ -846,6 +849,9 @@ void CServerHandler::onPacketReceived(const std::shared_ptr<INetworkConnection>
 	if(getState() == EClientState::DISCONNECTING)
 		return;
 
+	if(client && client->benchmark)
+		client->benchmark->onPackReceived(message.size());
+
 	CPack * pack = logicConnection->retrievePack(message);
 	ServerHandlerCPackVisitor visitor(*this);
 	pack->visit(visitor);
@@ -15,6 +15,7 @@
 #include "CPlayerInterface.h"
 #include "CServerHandler.h"
 #include "ClientNetPackVisitors.h"
+#include "GameBenchmark.h"
 #include "adventureMap/AdventureMapInterface.h"
 #include "battle/BattleInterface.h"
 #include "gui/CGuiHandler.h"
@@ -137,6 +138,9 @@ CClient::CClient()
 	applier = std::make_shared<CApplier<CBaseForCLApply>>();
 	registerTypesClientPacks(*applier);
 	gs = nullptr;
+
+	if(settings["session"]["benchmarkDays"].Integer() > 0)
+		benchmark = std::make_unique<GameBenchmark>(settings["session"]["benchmarkDays"].Integer());
 }
 
 CClient::~CClient() = default;
@@ -480,6 +484,11 @@ std::string CClient::aiNameForPlayer(bool battleAI, bool alliedToHuman)
 	std::string goodAI = battleAI ? goodBattleAI : goodAdventureAI;
 	std::string badAI = battleAI ? "StupidAI" : "EmptyAI";
 
+	// AI's requested with --ai option, for consecutive players
+	const auto & requestedAIs = settings["session"]["ai"].Vector();
+	if(!battleAI && battleints.size() < requestedAIs.size())
+		return requestedAIs[battleints.size()].String();
+
 	//TODO what about human players
 	if(battleints.size() >= sensibleAILimit)
 		return badAI;
@@ -548,6 +557,16 @@ int CClient::sendRequest(const CPackForServer * request, PlayerColor player)
 	return requestID;
 }
 
+void CClient::waitForRequest(int requestID)
+{
+	waitingRequest.waitWhileContains(requestID);
+}
+
+std::optional<BattleAction> CClient::makeSurrenderRetreatDecision(PlayerColor player, const BattleID & battleID, const BattleStateInfoForRetreat & battleState)
+{
+	return playerint[player]->makeSurrenderRetreatDecision(battleID, battleState);
+}
+
 void CClient::battleStarted(const BattleInfo * info)
 {
 	std::shared_ptr<CPlayerInterface> att;
@@ -676,6 +695,7 @@ std::shared_ptr<const CPathsInfo> CClient::getPathsInfo(const CGHeroInstance * h
 	{
 		auto paths = std::make_shared<CPathsInfo>(getMapSize(), h);
 
+		GameBenchmark::PathfindingScope benchmarkScope(benchmark.get());
 		gs->calculatePaths(h, *paths.get());
 
 		pathCache[h] = paths;
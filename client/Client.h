@@ -12,6 +12,7 @@
 #include <memory>
 #include <vcmi/Environment.h>
 
+#include "../CCallback.h"
 #include "../lib/IGameCallback.h"
 
 VCMI_LIB_NAMESPACE_BEGIN
@@ -46,6 +47,7 @@ class CBattleCallback;
 class CCallback;
 class CClient;
 class CBaseForCLApply;
+class GameBenchmark;
 
 namespace boost { class thread; }
 
@@ -110,7 +112,7 @@ public:
 };
 
 /// Class which handles client - server logic
-class CClient : public IGameCallback, public Environment
+class CClient : public IGameCallback, public Environment, public ICallbackRequestHandler
 {
 public:
 	std::map<PlayerColor, std::shared_ptr<CGameInterface>> playerint;
@@ -120,6 +122,9 @@ public:
 
 	std::unique_ptr<BattleAction> currentBattleAction;
 
+	/// null unless game was started with --benchmark-days
+	std::unique_ptr<GameBenchmark> benchmark;
+
 	CClient();
 	~CClient();
 
@@ -148,7 +153,9 @@ public:
 	static ThreadSafeVector<int> waitingRequest; //FIXME: make this normal field (need to join all threads before client destruction)
 
 	void handlePack(CPack * pack); //applies the given pack and deletes it
-	int sendRequest(const CPackForServer * request, PlayerColor player); //returns ID given to that request
+	int sendRequest(const CPackForServer * request, PlayerColor player) override; //returns ID given to that request
+	void waitForRequest(int requestID) override;
+	std::optional<BattleAction> makeSurrenderRetreatDecision(PlayerColor player, const BattleID & battleID, const BattleStateInfoForRetreat & battleState) override;
 
 	void battleStarted(const BattleInfo * info);
 	void battleFinished(const BattleID & battleID);
@@ -0,0 +1,169 @@
+/*
+ * GameBenchmark.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "GameBenchmark.h"
+
+#include "../lib/json/JsonNode.h"
+
+static double toMilliseconds(std::chrono::steady_clock::duration duration)
+{
+	return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+GameBenchmark::PathfindingScope::PathfindingScope(GameBenchmark * benchmark)
+	: benchmark(benchmark)
+	, start(benchmark ? Clock::now() : Clock::time_point())
+{
+}
+
+GameBenchmark::PathfindingScope::~PathfindingScope()
+{
+	if(!benchmark)
+		return;
+
+	benchmark->pathfindingCalls++;
+	benchmark->pathfindingTime += (Clock::now() - start).count();
+}
+
+GameBenchmark::GameBenchmark(int daysToPlay)
+	: daysToPlay(daysToPlay)
+{
+}
+
+void GameBenchmark::onPackReceived(size_t bytes)
+{
+	boost::mutex::scoped_lock lock(statsMutex);
+	current.packs++;
+	current.packsBytes += bytes;
+}
+
+void GameBenchmark::onTurnStarted(PlayerColor player)
+{
+	boost::mutex::scoped_lock lock(statsMutex);
+	turnStarts[player] = Clock::now();
+}
+
+void GameBenchmark::onTurnEnded(PlayerColor player)
+{
+	boost::mutex::scoped_lock lock(statsMutex);
+	auto it = turnStarts.find(player);
+	if(it == turnStarts.end())
+		return;
+
+	current.turns[player] += Clock::now() - it->second;
+	turnStarts.erase(it);
+}
+
+void GameBenchmark::onBattleStarted(BattleID battle)
+{
+	boost::mutex::scoped_lock lock(statsMutex);
+	battleStarts[battle] = Clock::now();
+}
+
+void GameBenchmark::onBattleEnded(BattleID battle)
+{
+	boost::mutex::scoped_lock lock(statsMutex);
+	auto it = battleStarts.find(battle);
+	if(it == battleStarts.end())
+		return;
+
+	current.battles++;
+	current.battlesTime += Clock::now() - it->second;
+	battleStarts.erase(it);
+}
+
+void GameBenchmark::finishDay()
+{
+	current.total = Clock::now() - dayStart;
+	current.pathfindingCalls = pathfindingCalls.exchange(0);
+	current.pathfinding = Clock::duration(pathfindingTime.exchange(0));
+	days.push_back(current);
+}
+
+void GameBenchmark::onNewDay(int day)
+{
+	boost::mutex::scoped_lock lock(statsMutex);
+
+	// packs received before first day are part of game start and are not reported
+	if(current.day != 0)
+		finishDay();
+
+	current = DayStats();
+	current.day = day;
+	dayStart = Clock::now();
+
+	if(day > daysToPlay)
+		finished = true;
+}
+
+bool GameBenchmark::isFinished() const
+{
+	return finished;
+}
+
+void GameBenchmark::printReport(std::ostream & out) const
+{
+	DayStats total;
+
+	for(const auto & day : days)
+	{
+		out << boost::format("Day %d: %.0f ms") % day.day % toMilliseconds(day.total);
+		for(const auto & turn : day.turns)
+			out << boost::format(", %s %.0f ms") % turn.first.toString() % toMilliseconds(turn.second);
+		out << boost::format(", pathfinding %d runs %.0f ms, battles %d %.0f ms, packs %d %.1f KB\n")
+			% day.pathfindingCalls
+			% toMilliseconds(day.pathfinding)
+			% day.battles
+			% toMilliseconds(day.battlesTime)
+			% day.packs
+			% (day.packsBytes / 1024.0);
+
+		total.total += day.total;
+		for(const auto & turn : day.turns)
+			total.turns[turn.first] += turn.second;
+		total.pathfindingCalls += day.pathfindingCalls;
+		total.pathfinding += day.pathfinding;
+		total.battles += day.battles;
+		total.battlesTime += day.battlesTime;
+		total.packs += day.packs;
+		total.packsBytes += day.packsBytes;
+	}
+
+	out << boost::format("Total: %d days in %.2f s\n") % days.size() % (toMilliseconds(total.total) / 1000.0);
+	for(const auto & turn : total.turns)
+		out << boost::format("  turns of %s: %.2f s\n") % turn.first.toString() % (toMilliseconds(turn.second) / 1000.0);
+	out << boost::format("  pathfinding: %d runs, %.2f s\n") % total.pathfindingCalls % (toMilliseconds(total.pathfinding) / 1000.0);
+	out << boost::format("  battles: %d, %.2f s\n") % total.battles % (toMilliseconds(total.battlesTime) / 1000.0);
+	out << boost::format("  packs: %d, %.1f KB\n") % total.packs % (total.packsBytes / 1024.0);
+}
+
+void GameBenchmark::saveReport(const boost::filesystem::path & path) const
+{
+	JsonNode report;
+
+	for(const auto & day : days)
+	{
+		JsonNode entry;
+		entry["day"].Integer() = day.day;
+		entry["totalMs"].Float() = toMilliseconds(day.total);
+		for(const auto & turn : day.turns)
+			entry["turnsMs"][turn.first.toString()].Float() = toMilliseconds(turn.second);
+		entry["pathfindingRuns"].Integer() = day.pathfindingCalls;
+		entry["pathfindingMs"].Float() = toMilliseconds(day.pathfinding);
+		entry["battles"].Integer() = day.battles;
+		entry["battlesMs"].Float() = toMilliseconds(day.battlesTime);
+		entry["packs"].Integer() = day.packs;
+		entry["packsBytes"].Integer() = day.packsBytes;
+		report["days"].Vector().push_back(entry);
+	}
+
+	std::ofstream file(path.c_str(), std::ofstream::out | std::ofstream::trunc);
+	file << report.toString();
+}
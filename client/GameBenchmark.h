@@ -0,0 +1,77 @@
+/*
+ * GameBenchmark.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include "../lib/constants/EntityIdentifiers.h"
+
+/// Measures performance of AI-only game started with --benchmark-days
+/// Collects per-day timings of AI turns, pathfinding, battles and received packs,
+/// and prints report once requested number of days is played
+class GameBenchmark : boost::noncopyable
+{
+	using Clock = std::chrono::steady_clock;
+
+	struct DayStats
+	{
+		int day = 0;
+		Clock::duration total{};
+		std::map<PlayerColor, Clock::duration> turns;
+		int64_t pathfindingCalls = 0;
+		Clock::duration pathfinding{};
+		int battles = 0;
+		Clock::duration battlesTime{};
+		int64_t packs = 0;
+		int64_t packsBytes = 0;
+	};
+
+	int daysToPlay;
+	std::atomic<bool> finished = false;
+
+	boost::mutex statsMutex;
+	std::vector<DayStats> days;
+	DayStats current;
+	Clock::time_point dayStart;
+	std::map<PlayerColor, Clock::time_point> turnStarts;
+	std::map<BattleID, Clock::time_point> battleStarts;
+
+	// pathfinding is called concurrently by AI threads
+	std::atomic<int64_t> pathfindingCalls = 0;
+	std::atomic<int64_t> pathfindingTime = 0;
+
+	void finishDay();
+
+public:
+	/// Measures duration of single pathfinder run
+	class PathfindingScope : boost::noncopyable
+	{
+		GameBenchmark * benchmark;
+		Clock::time_point start;
+
+	public:
+		explicit PathfindingScope(GameBenchmark * benchmark);
+		~PathfindingScope();
+	};
+
+	explicit GameBenchmark(int daysToPlay);
+
+	void onPackReceived(size_t bytes);
+	void onTurnStarted(PlayerColor player);
+	void onTurnEnded(PlayerColor player);
+	void onBattleStarted(BattleID battle);
+	void onBattleEnded(BattleID battle);
+
+	void onNewDay(int day);
+
+	/// Returns true once requested number of days is played
+	bool isFinished() const;
+
+	void printReport(std::ostream & out) const;
+	void saveReport(const boost::filesystem::path & path) const;
+};
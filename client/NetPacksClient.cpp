@@ -24,6 +24,7 @@
 #include "CMT.h"
 #include "GameChatHandler.h"
 #include "CServerHandler.h"
+#include "GameBenchmark.h"
 
 #include "../CCallback.h"
 #include "../lib/filesystem/Filesystem.h"
@@ -361,6 +362,10 @@ void ApplyClientNetPackVisitor::visitHeroVisit(HeroVisit & pack)
 void ApplyClientNetPackVisitor::visitNewTurn(NewTurn & pack)
 {
 	cl.invalidatePaths();
+
+	// report is printed and application is closed by main thread, see CMT.cpp
+	if(cl.benchmark)
+		cl.benchmark->onNewDay(pack.day);
 }
 
 void ApplyClientNetPackVisitor::visitGiveBonus(GiveBonus & pack)
@@ -760,6 +765,9 @@ void ApplyFirstClientNetPackVisitor::visitBattleStart(BattleStart & pack)
 
 void ApplyClientNetPackVisitor::visitBattleStart(BattleStart & pack)
 {
+	if(cl.benchmark)
+		cl.benchmark->onBattleStarted(pack.battleID);
+
 	cl.battleStarted(pack.info);
 }
 
@@ -858,6 +866,9 @@ void ApplyClientNetPackVisitor::visitStacksInjured(StacksInjured & pack)
 
 void ApplyClientNetPackVisitor::visitBattleResultsApplied(BattleResultsApplied & pack)
 {
+	if(cl.benchmark)
+		cl.benchmark->onBattleEnded(pack.battleID);
+
 	callInterfaceIfPresent(cl, pack.player1, &IGameEventsReceiver::battleResultsApplied);
 	callInterfaceIfPresent(cl, pack.player2, &IGameEventsReceiver::battleResultsApplied);
 	callInterfaceIfPresent(cl, PlayerColor::SPECTATOR, &IGameEventsReceiver::battleResultsApplied);
@@ -910,6 +921,9 @@ void ApplyClientNetPackVisitor::visitPlayerStartsTurn(PlayerStartsTurn & pack)
 {
 	logNetwork->debug("Server gives turn to %s", pack.player.toString());
 
+	if(cl.benchmark)
+		cl.benchmark->onTurnStarted(pack.player);
+
 	callAllInterfaces(cl, &IGameEventsReceiver::playerStartsTurn, pack.player);
 	callOnlyThatInterface(cl, pack.player, &CGameInterface::yourTurn, pack.queryID);
 }
@@ -918,6 +932,9 @@ void ApplyClientNetPackVisitor::visitPlayerEndsTurn(PlayerEndsTurn & pack)
 {
 	logNetwork->debug("Server ends turn of %s", pack.player.toString());
 
+	if(cl.benchmark)
+		cl.benchmark->onTurnEnded(pack.player);
+
 	callAllInterfaces(cl, &IGameEventsReceiver::playerEndsTurn, pack.player);
 }
 
@@ -45,14 +45,20 @@ CursorHandler::CursorHandler()
 	type = Cursor::Type::DEFAULT;
 	dndObject = nullptr;
 
-	cursors =
+	const std::vector<AnimationPath> cursorAnimations =
 	{
-		GH.renderHandler().loadAnimation(AnimationPath::builtin("CRADVNTR")),
-		GH.renderHandler().loadAnimation(AnimationPath::builtin("CRCOMBAT")),
-		GH.renderHandler().loadAnimation(AnimationPath::builtin("CRDEFLT")),
-		GH.renderHandler().loadAnimation(AnimationPath::builtin("CRSPELL"))
+		AnimationPath::builtin("CRADVNTR"),
+		AnimationPath::builtin("CRCOMBAT"),
+		AnimationPath::builtin("CRDEFLT"),
+		AnimationPath::builtin("CRSPELL")
 	};
 
+	// decode all cursors in parallel, loadAnimation will wait for them
+	GH.renderHandler().prefetchAnimations(cursorAnimations);
+
+	for (size_t i = 0; i < cursors.size(); ++i)
+		cursors[i] = GH.renderHandler().loadAnimation(cursorAnimations[i]);
+
 	for (auto & cursor : cursors)
 		cursor->preload();
 
@@ -41,6 +41,7 @@
 #include "../../lib/campaign/CampaignState.h"
 #include "../../lib/mapping/CMapInfo.h"
 #include "../../lib/mapping/CMapHeader.h"
+#include "../../lib/mapping/CMapService.h"
 #include "../../lib/mapping/MapFormat.h"
 #include "../../lib/TerrainHandler.h"
 
@@ -747,19 +748,28 @@ void SelectionTab::parseMaps(const std::unordered_set<ResourcePath> & files)
 {
 	logGlobal->debug("Parsing %d maps", files.size());
 	allItems.clear();
-	for(auto & file : files)
+
+	std::vector<ResourcePath> names(files.begin(), files.end());
+	CMapService mapService;
+	auto headers = mapService.loadMapHeaders(names);
+
+	for(size_t i = 0; i < names.size(); ++i)
 	{
+		// errors are already reported by map service
+		if(!headers[i])
+			continue;
+
 		try
 		{
 			auto mapInfo = std::make_shared<ElementInfo>();
-			mapInfo->mapInit(file.getName());
+			mapInfo->mapInit(names[i].getName(), std::move(headers[i]));
 
 			if (isMapSupported(*mapInfo))
 				allItems.push_back(mapInfo);
 		}
 		catch(std::exception & e)
 		{
-			logGlobal->error("Map %s is invalid. Message: %s", file.getName(), e.what());
+			logGlobal->error("Map %s is invalid. Message: %s", names[i].getName(), e.what());
 		}
 	}
 }
@@ -16,12 +16,16 @@
 #include "../CGameInfo.h"
 #include "../CPlayerInterface.h"
 #include "../gui/CGuiHandler.h"
+#include "../render/IRenderHandler.h"
 
 #include "../../lib/CGeneralTextHandler.h"
+#include "../../lib/RiverHandler.h"
+#include "../../lib/RoadHandler.h"
 #include "../../lib/TerrainHandler.h"
 #include "../../lib/UnlockGuard.h"
 #include "../../lib/mapObjectConstructors/CObjectClassesHandler.h"
 #include "../../lib/mapObjects/CGHeroInstance.h"
+#include "../../lib/mapObjects/MiscObjects.h"
 #include "../../lib/mapObjects/ObjectTemplate.h"
 #include "../../lib/mapping/CMap.h"
 
@@ -137,6 +141,55 @@ bool CMapHandler::compareObjectBlitOrder(const CGObjectInstance * a, const CGObj
 CMapHandler::CMapHandler(const CMap * map)
 	: map(map)
 {
+	prefetchAnimations();
+}
+
+CMapHandler::~CMapHandler()
+{
+	// drop animations of objects that were never rendered during this game
+	GH.renderHandler().cancelPrefetch();
+}
+
+void CMapHandler::prefetchAnimations()
+{
+	std::vector<AnimationPath> paths;
+
+	// map renderer loads every tileset once per each possible flip
+	auto addTileset = [&paths](const AnimationPath & path)
+	{
+		if(!path.empty())
+			paths.insert(paths.end(), 4, path);
+	};
+
+	for(const auto & terrain : VLC->terrainTypeHandler->objects)
+		addTileset(terrain->tilesFilename);
+	for(const auto & river : VLC->riverTypeHandler->objects)
+		addTileset(river->tilesFilename);
+	for(const auto & road : VLC->roadTypeHandler->objects)
+		addTileset(road->tilesFilename);
+
+	// map renderer caches object animations by name, so each of them is needed only once
+	std::set<AnimationPath> objectAnimations;
+
+	for(const auto & obj : map->objects)
+	{
+		if(!obj || !obj->appearance || obj->appearance->id == Obj::EVENT || obj->appearance->animationFile.empty())
+			continue;
+
+		const auto * boat = dynamic_cast<const CGBoat *>(obj.get());
+		if(boat && !boat->actualAnimation.empty())
+			objectAnimations.insert(boat->actualAnimation);
+		else
+			objectAnimations.insert(obj->appearance->animationFile);
+
+		if(obj->ID == Obj::HERO && obj->tempOwner.isValidPlayer())
+			objectAnimations.insert(AnimationPath::builtin("AF0" + std::to_string(obj->tempOwner.getNum())));
+	}
+
+	paths.insert(paths.end(), objectAnimations.begin(), objectAnimations.end());
+
+	logGlobal->debug("Prefetching %d map animations", paths.size());
+	GH.renderHandler().prefetchAnimations(paths);
 }
 
 const CMap * CMapHandler::getMap()
@@ -38,8 +38,12 @@ class CMapHandler
 	const CMap * map;
 	std::vector<IMapObjectObserver *> observers;
 
+	/// starts background decoding of terrain and object animations that will be needed to render this map
+	void prefetchAnimations();
+
 public:
 	explicit CMapHandler(const CMap * map);
+	~CMapHandler();
 
 	const CMap * getMap();
 
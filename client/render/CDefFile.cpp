@@ -42,20 +42,27 @@ class CFileCache
 	};
 
 	std::deque<FileData> cache;
+	/// cache is shared between main thread and animation prefetch threads
+	boost::mutex cacheMutex;
+
 public:
 	std::unique_ptr<ui8[]> getCachedFile(AnimationPath rid)
 	{
-		for(auto & file : cache)
 		{
-			if (file.name == rid)
-				return file.getCopy();
+			boost::mutex::scoped_lock lock(cacheMutex);
+			for(auto & file : cache)
+			{
+				if (file.name == rid)
+					return file.getCopy();
+			}
 		}
-		// Still here? Cache miss
+		// Still here? Cache miss. File is read without lock, so threads loading different files do not wait for each other
+		auto data =  CResourceHandler::get()->load(rid)->readAll();
+
+		boost::mutex::scoped_lock lock(cacheMutex);
 		if (cache.size() > cacheSize)
 			cache.pop_front();
 
-		auto data =  CResourceHandler::get()->load(rid)->readAll();
-
 		cache.emplace_back(std::move(rid), data.second, std::move(data.first));
 
 		return cache.back().getCopy();
@@ -35,4 +35,11 @@ public:
 
 	/// Creates empty CAnimation
 	virtual std::shared_ptr<CAnimation> createAnimation() = 0;
+
+	/// Starts loading and decoding of all frames of listed animations in background
+	/// Every listed path will be consumed by one of following loadAnimation calls with the same path
+	virtual void prefetchAnimations(const std::vector<AnimationPath> & paths) = 0;
+
+	/// Drops all prefetched animations that were not requested yet
+	virtual void cancelPrefetch() = 0;
 };
@@ -13,6 +13,20 @@
 #include "../render/CAnimation.h"
 #include "SDLImage.h"
 
+#include "../../lib/CThreadHelper.h"
+
+RenderHandler::~RenderHandler()
+{
+	{
+		boost::mutex::scoped_lock lock(prefetchMutex);
+		prefetchStopped = true;
+		prefetchQueue.clear();
+	}
+	prefetchCondition.notify_all();
+
+	for(auto & worker : prefetchWorkers)
+		worker.join();
+}
 
 std::shared_ptr<IImage> RenderHandler::loadImage(const ImagePath & path)
 {
@@ -31,6 +45,10 @@ std::shared_ptr<IImage> RenderHandler::createImage(SDL_Surface * source)
 
 std::shared_ptr<CAnimation> RenderHandler::loadAnimation(const AnimationPath & path)
 {
+	auto prefetched = takePrefetchedAnimation(path);
+	if(prefetched)
+		return prefetched;
+
 	return std::make_shared<CAnimation>(path);
 }
 
@@ -38,3 +56,109 @@ std::shared_ptr<CAnimation> RenderHandler::createAnimation()
 {
 	return std::make_shared<CAnimation>();
 }
+
+std::shared_ptr<CAnimation> RenderHandler::takePrefetchedAnimation(const AnimationPath & path)
+{
+	boost::mutex::scoped_lock lock(prefetchMutex);
+
+	for(;;)
+	{
+		auto ready = prefetchedAnimations.find(path);
+		if(ready != prefetchedAnimations.end())
+		{
+			auto result = ready->second.back();
+			ready->second.pop_back();
+			if(ready->second.empty())
+				prefetchedAnimations.erase(ready);
+			return result;
+		}
+
+		// animation is still waiting in queue - it is faster to decode it right here than to wait for a free worker
+		auto queued = std::find(prefetchQueue.begin(), prefetchQueue.end(), path);
+		if(queued != prefetchQueue.end())
+		{
+			prefetchQueue.erase(queued);
+			return nullptr;
+		}
+
+		if(!prefetchInProgress.count(path))
+			return nullptr;
+
+		prefetchCondition.wait(lock);
+	}
+}
+
+void RenderHandler::prefetchAnimations(const std::vector<AnimationPath> & paths)
+{
+	if(paths.empty())
+		return;
+
+	{
+		boost::mutex::scoped_lock lock(prefetchMutex);
+
+		prefetchQueue.insert(prefetchQueue.end(), paths.begin(), paths.end());
+
+		if(prefetchWorkers.empty())
+		{
+			// leave one core for main thread that keeps loading everything else
+			int threadsCount = std::max(1, static_cast<int>(boost::thread::hardware_concurrency()) - 1);
+
+			for(int i = 0; i < threadsCount; ++i)
+				prefetchWorkers.emplace_back(&RenderHandler::prefetchWorkerLoop, this);
+		}
+	}
+	prefetchCondition.notify_all();
+}
+
+void RenderHandler::cancelPrefetch()
+{
+	boost::mutex::scoped_lock lock(prefetchMutex);
+	prefetchQueue.clear();
+	prefetchedAnimations.clear();
+	prefetchGeneration++;
+}
+
+void RenderHandler::prefetchWorkerLoop()
+{
+	setThreadName("prefetch");
+
+	boost::mutex::scoped_lock lock(prefetchMutex);
+
+	for(;;)
+	{
+		prefetchCondition.wait(lock, [this](){ return prefetchStopped || !prefetchQueue.empty(); });
+
+		if(prefetchStopped)
+			return;
+
+		AnimationPath path = prefetchQueue.front();
+		prefetchQueue.pop_front();
+		prefetchInProgress[path]++;
+
+		uint32_t generation = prefetchGeneration;
+		std::shared_ptr<CAnimation> animation;
+
+		lock.unlock();
+		try
+		{
+			// all images are decoded into software surfaces that are not bound to renderer or to main thread
+			animation = std::make_shared<CAnimation>(path);
+			animation->preload();
+		}
+		catch(const std::exception & e)
+		{
+			logGlobal->error("Failed to prefetch animation %s: %s", path.getOriginalName(), e.what());
+			animation.reset();
+		}
+		lock.lock();
+
+		if(--prefetchInProgress[path] == 0)
+			prefetchInProgress.erase(path);
+
+		// prefetch was cancelled while this animation was being decoded
+		if(animation && generation == prefetchGeneration)
+			prefetchedAnimations[path].push_back(animation);
+
+		prefetchCondition.notify_all();
+	}
+}
@@ -13,7 +13,28 @@
 
 class RenderHandler : public IRenderHandler
 {
+	/// Protects all prefetch-related fields below
+	boost::mutex prefetchMutex;
+	boost::condition_variable prefetchCondition;
+
+	/// Animations that were requested for prefetching but not picked up by any worker yet
+	std::deque<AnimationPath> prefetchQueue;
+	/// Number of animations with given path that are being decoded right now
+	std::map<AnimationPath, int> prefetchInProgress;
+	/// Fully decoded animations that are waiting for loadAnimation call
+	std::map<AnimationPath, std::vector<std::shared_ptr<CAnimation>>> prefetchedAnimations;
+
+	std::vector<boost::thread> prefetchWorkers;
+	/// Incremented on every cancellation to discard results of decoding that was already running
+	uint32_t prefetchGeneration = 0;
+	bool prefetchStopped = false;
+
+	void prefetchWorkerLoop();
+	std::shared_ptr<CAnimation> takePrefetchedAnimation(const AnimationPath & path);
+
 public:
+	~RenderHandler();
+
 	std::shared_ptr<IImage> loadImage(const ImagePath & path) override;
 	std::shared_ptr<IImage> loadImage(const ImagePath & path, EImageBlitMode mode) override;
 
@@ -22,4 +43,7 @@ public:
 	std::shared_ptr<CAnimation> loadAnimation(const AnimationPath & path) override;
 
 	std::shared_ptr<CAnimation> createAnimation() override;
+
+	void prefetchAnimations(const std::vector<AnimationPath> & paths) override;
+	void cancelPrefetch() override;
 };
@@ -465,6 +465,25 @@ std::vector <const CGObjectInstance * > CGameInfoCallback::getVisitableObjs(int3
 
 	return ret;
 }
+std::vector <const CGObjectInstance * > CGameInfoCallback::getVisitableObjsInRange(int3 pos, int radius, std::optional<MapObjectID> type) const
+{
+	auto ret = gs->map->getObjectIndex().getObjectsInRange(pos, radius, type);
+
+	vstd::erase_if(ret, [this](const CGObjectInstance * obj)
+	{
+		return !obj->isVisitable() || !isVisible(obj->visitablePos()) || (!getPlayerID() && obj->ID == Obj::EVENT);
+	});
+	return ret;
+}
+
+const CGObjectInstance * CGameInfoCallback::getNearestVisitableObj(int3 pos, MapObjectID type) const
+{
+	return gs->map->getObjectIndex().getNearestObject(pos, type, [this](const CGObjectInstance * obj)
+	{
+		return obj->isVisitable() && isVisible(obj->visitablePos()) && (getPlayerID() || obj->ID != Obj::EVENT);
+	});
+}
+
 const CGObjectInstance * CGameInfoCallback::getTopObj (int3 pos) const
 {
 	return vstd::backOrNull(getVisitableObjs(pos));
@@ -515,9 +534,9 @@ EDiggingStatus CGameInfoCallback::getTileDigStatus(int3 tile, bool verbose) cons
 	if(!isVisible(tile))
 		return EDiggingStatus::UNKNOWN;
 
-	for(const auto & object : gs->map->objects)
+	for(const auto * object : gs->map->getObjectIndex().getObjectsInRange(tile, 0, Obj::HOLE))
 	{
-		if(object && object->ID == Obj::HOLE && object->pos == tile)
+		if(object->pos == tile)
 			return EDiggingStatus::TILE_OCCUPIED;
 	}
 	return getTile(tile)->getDiggingStatus();
@@ -540,7 +559,7 @@ std::shared_ptr<const boost::multi_array<TerrainTile*, 3>> CGameInfoCallback::ge
 		for(tile.x = 0; tile.x < width; tile.x++)
 			for(tile.y = 0; tile.y < height; tile.y++)
 			{
-				if ((*team->fogOfWarMap)[tile.z][tile.x][tile.y])
+				if (team->fogOfWarMap.isVisible(tile))
 					(*ptr)[tile.z][tile.x][tile.y] = &gs->map->getTile(tile);
 				else
 					(*ptr)[tile.z][tile.x][tile.y] = nullptr;
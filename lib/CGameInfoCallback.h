@@ -187,6 +187,10 @@ public:
 	virtual std::vector <const CGObjectInstance * > getBlockingObjs(int3 pos)const;
 	std::vector <const CGObjectInstance * > getVisitableObjs(int3 pos, bool verbose = true) const override;
 	virtual std::vector <const CGObjectInstance * > getFlaggableObjects(int3 pos) const;
+	/// visible objects on the same level as pos within radius, optionally only of specified type
+	virtual std::vector <const CGObjectInstance * > getVisitableObjsInRange(int3 pos, int radius, std::optional<MapObjectID> type = std::nullopt) const;
+	/// visible object of specified type closest to pos, or nullptr if there are none
+	virtual const CGObjectInstance * getNearestVisitableObj(int3 pos, MapObjectID type) const;
 	virtual const CGObjectInstance * getTopObj (int3 pos) const;
 	virtual PlayerColor getOwner(ObjectInstanceID heroID) const;
 
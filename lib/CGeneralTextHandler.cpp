@@ -248,11 +248,17 @@ bool CLegacyConfigParser::endLine()
 	return curr < end;
 }
 
+/// Map headers register their texts on construction and may be loaded from multiple threads,
+/// while texts of all containers are looked up through sub-containers of global text handler
+static boost::shared_mutex localizationsMutex;
+
 void TextLocalizationContainer::registerStringOverride(const std::string & modContext, const std::string & language, const TextIdentifier & UID, const std::string & localized)
 {
 	assert(!modContext.empty());
 	assert(!language.empty());
 
+	boost::unique_lock<boost::shared_mutex> lock(localizationsMutex);
+
 	// NOTE: implicitly creates entry, intended - strings added by maps, campaigns, vcmi and potentially - UI mods are not registered anywhere at the moment
 	auto & entry = stringsLocalizations[UID.get()];
 
@@ -264,24 +270,32 @@ void TextLocalizationContainer::registerStringOverride(const std::string & modCo
 
 void TextLocalizationContainer::addSubContainer(const TextLocalizationContainer & container)
 {
+	boost::unique_lock<boost::shared_mutex> lock(localizationsMutex);
 	assert(!vstd::contains(subContainers, &container));
 	subContainers.push_back(&container);
 }
 
 void TextLocalizationContainer::removeSubContainer(const TextLocalizationContainer & container)
 {
+	boost::unique_lock<boost::shared_mutex> lock(localizationsMutex);
 	assert(vstd::contains(subContainers, &container));
 
 	subContainers.erase(std::remove(subContainers.begin(), subContainers.end(), &container), subContainers.end());
 }
 
 const std::string & TextLocalizationContainer::deserialize(const TextIdentifier & identifier) const
+{
+	boost::shared_lock<boost::shared_mutex> lock(localizationsMutex);
+	return deserializeLocked(identifier);
+}
+
+const std::string & TextLocalizationContainer::deserializeLocked(const TextIdentifier & identifier) const
 {
 	if(stringsLocalizations.count(identifier.get()) == 0)
 	{
 		for(auto containerIter = subContainers.rbegin(); containerIter != subContainers.rend(); ++containerIter)
-			if((*containerIter)->identifierExists(identifier))
-				return (*containerIter)->deserialize(identifier);
+			if((*containerIter)->stringsLocalizations.count(identifier.get()))
+				return (*containerIter)->deserializeLocked(identifier);
 		
 		logGlobal->error("Unable to find localization for string '%s'", identifier.get());
 		return identifier.get();
@@ -301,6 +315,8 @@ void TextLocalizationContainer::registerString(const std::string & modContext, c
 	assert(UID.get().find("..") == std::string::npos); // invalid identifier - there is section that was evaluated to empty string
 	//assert(stringsLocalizations.count(UID.get()) == 0); // registering already registered string?
 
+	boost::unique_lock<boost::shared_mutex> lock(localizationsMutex);
+
 	if(stringsLocalizations.count(UID.get()) > 0)
 	{
 		auto & value = stringsLocalizations[UID.get()];
@@ -383,6 +399,7 @@ void TextLocalizationContainer::loadTranslationOverrides(const std::string & lan
 
 bool TextLocalizationContainer::identifierExists(const TextIdentifier & UID) const
 {
+	boost::shared_lock<boost::shared_mutex> lock(localizationsMutex);
 	return stringsLocalizations.count(UID.get());
 }
 
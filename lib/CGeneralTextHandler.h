@@ -152,6 +152,9 @@ protected:
 	void registerStringOverride(const std::string & modContext, const std::string & language, const TextIdentifier & UID, const std::string & localized);
 	
 	std::string getModLanguage(const std::string & modContext);
+
+	/// deserialize() of this container and its sub-containers, lock must be held by caller
+	const std::string & deserializeLocked(const TextIdentifier & identifier) const;
 	
 public:
 	/// validates translation of specified language for specified mod
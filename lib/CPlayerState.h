@@ -17,6 +17,7 @@
 #include "ResourceSet.h"
 #include "TurnTimerInfo.h"
 #include "ConstTransitivePtr.h"
+#include "gameState/FogOfWarMap.h"
 
 VCMI_LIB_NAMESPACE_BEGIN
 
@@ -124,8 +125,7 @@ struct DLL_LINKAGE TeamState : public CBonusSystemNode
 public:
 	TeamID id; //position in gameState::teams
 	std::set<PlayerColor> players; // members of this team
-	//TODO: boost::array, bool if possible
-	std::unique_ptr<boost::multi_array<ui8, 3>> fogOfWarMap; //[z][x][y] true - visible, false - hidden
+	FogOfWarMap fogOfWarMap;
 
 	TeamState();
 
@@ -133,7 +133,22 @@ public:
 	{
 		h & id;
 		h & players;
-		h & fogOfWarMap;
+		if (h.version >= Handler::Version::PACKED_FOG_OF_WAR)
+		{
+			h & fogOfWarMap;
+		}
+		else
+		{
+			std::unique_ptr<boost::multi_array<ui8, 3>> legacyFogOfWar;
+			h & legacyFogOfWar;
+
+			auto shape = legacyFogOfWar->shape();
+			fogOfWarMap.resize(int3(shape[1], shape[2], shape[0]));
+			for(size_t z = 0; z < shape[0]; z++)
+				for(size_t x = 0; x < shape[1]; x++)
+					for(size_t y = 0; y < shape[2]; y++)
+						fogOfWarMap.setVisible(int3(x, y, z), (*legacyFogOfWar)[z][x][y]);
+		}
 		h & static_cast<CBonusSystemNode&>(*this);
 	}
 
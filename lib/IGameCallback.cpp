@@ -93,21 +93,18 @@ void CPrivilegedInfoCallback::getTilesInRange(std::unordered_set<int3> & tiles,
 	else
 	{
 		const TeamState * team = !player ? nullptr : gs->getPlayerTeam(*player);
-		for (int xd = std::max<int>(pos.x - radious , 0); xd <= std::min<int>(pos.x + radious, gs->map->width - 1); xd++)
+		for (int yd = std::max<int>(pos.y - radious, 0); yd <= std::min<int>(pos.y + radious, gs->map->height - 1); yd++)
 		{
-			for (int yd = std::max<int>(pos.y - radious, 0); yd <= std::min<int>(pos.y + radious, gs->map->height - 1); yd++)
+			int halfWidth = FogOfWarMap::rangeHalfWidth(yd - pos.y, radious, distanceFormula);
+			if(halfWidth < 0)
+				continue;
+
+			for (int xd = std::max<int>(pos.x - halfWidth, 0); xd <= std::min<int>(pos.x + halfWidth, gs->map->width - 1); xd++)
 			{
 				int3 tilePos(xd,yd,pos.z);
-				int distance = pos.dist(tilePos, distanceFormula);
-
-				if(distance <= radious)
-				{
-					if(!player
-						|| (mode == ETileVisibility::HIDDEN  && (*team->fogOfWarMap)[pos.z][xd][yd] == 0)
-						|| (mode == ETileVisibility::REVEALED && (*team->fogOfWarMap)[pos.z][xd][yd] == 1)
-					)
-						tiles.insert(int3(xd,yd,pos.z));
-				}
+
+				if(!player || team->fogOfWarMap.isVisible(tilePos) == (mode == ETileVisibility::REVEALED))
+					tiles.insert(tilePos);
 			}
 		}
 	}
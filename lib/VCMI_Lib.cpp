@@ -32,6 +32,8 @@
 #include "IGameEventsReceiver.h"
 #include "CStopWatch.h"
 #include "VCMIDirs.h"
+#include "filesystem/AdapterLoaders.h"
+#include "filesystem/CArchiveLoader.h"
 #include "filesystem/Filesystem.h"
 #include "CConsoleHandler.h"
 #include "rmg/CRmgTemplateStorage.h"
@@ -171,6 +173,14 @@ void LibClasses::updateEntity(Metatype metatype, int32_t index, const JsonNode &
 	}
 }
 
+static void logResourceLookups(const std::string & phase)
+{
+	auto archiveStatistics = CArchiveLoader::getStatistics();
+
+	logGlobal->debug("\t%s: %d resource lookups", phase, CFilesystemList::takeLookupsCount());
+	logGlobal->debug("\tArchives: %d bytes read, %d bytes inflated, %d inflated entries loaded from cache", archiveStatistics.bytesRead, archiveStatistics.bytesInflated, archiveStatistics.cacheHits);
+}
+
 void LibClasses::loadFilesystem(bool extractArchives)
 {
 	CStopWatch loadTime;
@@ -180,6 +190,7 @@ void LibClasses::loadFilesystem(bool extractArchives)
 
 	CResourceHandler::load("config/filesystem.json", extractArchives);
 	logGlobal->info("\tData loading: %d ms", loadTime.getDiff());
+	logResourceLookups("Filesystem");
 }
 
 void LibClasses::loadModFilesystem()
@@ -192,6 +203,7 @@ void LibClasses::loadModFilesystem()
 
 	modh->loadModFilesystems();
 	logGlobal->info("\tMod filesystems: %d ms", loadTime.getDiff());
+	logResourceLookups("Mod filesystems");
 }
 
 static void logHandlerLoaded(const std::string & name, CStopWatch & timer)
@@ -235,9 +247,11 @@ void LibClasses::init(bool onlyEssential)
 	createHandler(battlefieldsHandler, "Battlefields", pomtime);
 	createHandler(obstacleHandler, "Obstacles", pomtime);
 	logGlobal->info("\tInitializing handlers: %d ms", totalTime.getDiff());
+	logResourceLookups("Handlers");
 
 	modh->load();
 	modh->afterLoad(onlyEssential);
+	logResourceLookups("Mods content");
 }
 
 #if SCRIPTING_ENABLED
@@ -735,7 +735,7 @@ DamageEstimation CBattleInfoCallback::calculateDmgRange(const BattleAttackInfo &
 {
 	DamageCalculator calculator(*this, info);
 
-	return calculator.calculateDmgRange();
+	return calculator.calculateDmgRange(damageMatrix.getFactors(calculator, info));
 }
 
 DamageEstimation CBattleInfoCallback::battleEstimateDamage(const battle::Unit * attacker, const battle::Unit * defender, BattleHex attackerPosition, DamageEstimation * retaliationDmg) const
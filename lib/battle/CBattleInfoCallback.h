@@ -13,6 +13,7 @@
 
 #include "ReachabilityInfo.h"
 #include "BattleAttackInfo.h"
+#include "DamageMatrix.h"
 
 VCMI_LIB_NAMESPACE_BEGIN
 
@@ -51,6 +52,8 @@ struct DLL_LINKAGE BattleClientInterfaceData
 
 class DLL_LINKAGE CBattleInfoCallback : public virtual CBattleInfoEssentials
 {
+	mutable DamageMatrix damageMatrix;
+
 public:
 	std::optional<int> battleIsFinished() const override; //return none if battle is ongoing; otherwise the victorious side (0/1) or 2 if it is a draw
 
@@ -108,10 +108,10 @@ DamageRange DamageCalculator::getBaseDamageBlessCurse() const
 	return modifiedDamage;
 }
 
-DamageRange DamageCalculator::getBaseDamageStack() const
+DamageRange DamageCalculator::getBaseDamageStack(const DamageBaseFactors & factors) const
 {
 	auto stackSize = info.attacker->getCount();
-	auto baseDamage = getBaseDamageBlessCurse();
+	auto baseDamage = factors.baseDamageSingle;
 	return {
 		baseDamage.min * stackSize,
 		baseDamage.max * stackSize
@@ -244,17 +244,29 @@ double DamageCalculator::getAttackDeathBlowFactor() const
 	return 0.0;
 }
 
-double DamageCalculator::getAttackDoubleDamageFactor() const
+double DamageCalculator::getAttackDoubleDamageFactor(const DamageBaseFactors & factors) const
 {
-	if(info.doubleDamage) {
-		const auto cachingStr = "type_BONUS_DAMAGE_PERCENTAGEs_" + std::to_string(info.attacker->creatureIndex());
-		const auto selector = Selector::typeSubtype(BonusType::BONUS_DAMAGE_PERCENTAGE, BonusSubtypeID(info.attacker->creatureId()));
-		return info.attacker->valOfBonuses(selector, cachingStr) / 100.0;
-	}
+	if(info.doubleDamage)
+		return factors.attackDoubleDamage;
 	return 0.0;
 }
 
-double DamageCalculator::getAttackJoustingFactor() const
+double DamageCalculator::getAttackDoubleDamageValue() const
+{
+	const auto cachingStr = "type_BONUS_DAMAGE_PERCENTAGEs_" + std::to_string(info.attacker->creatureIndex());
+	const auto selector = Selector::typeSubtype(BonusType::BONUS_DAMAGE_PERCENTAGE, BonusSubtypeID(info.attacker->creatureId()));
+	return info.attacker->valOfBonuses(selector, cachingStr) / 100.0;
+}
+
+double DamageCalculator::getAttackJoustingFactor(const DamageBaseFactors & factors) const
+{
+	//applying jousting bonus
+	if(info.chargeDistance > 0)
+		return info.chargeDistance * factors.attackJousting / 100.0;
+	return 0.0;
+}
+
+int DamageCalculator::getAttackJoustingValue() const
 {
 	const std::string cachingStrJousting = "type_JOUSTING";
 	static const auto selectorJousting = Selector::type()(BonusType::JOUSTING);
@@ -262,10 +274,9 @@ double DamageCalculator::getAttackJoustingFactor() const
 	const std::string cachingStrChargeImmunity = "type_CHARGE_IMMUNITY";
 	static const auto selectorChargeImmunity = Selector::type()(BonusType::CHARGE_IMMUNITY);
 
-	//applying jousting bonus
-	if(info.chargeDistance > 0 && info.attacker->hasBonus(selectorJousting, cachingStrJousting) && !info.defender->hasBonus(selectorChargeImmunity, cachingStrChargeImmunity))
-		return info.chargeDistance * (info.attacker->valOfBonuses(selectorJousting))/100.0;
-	return 0.0;
+	if(info.attacker->hasBonus(selectorJousting, cachingStrJousting) && !info.defender->hasBonus(selectorChargeImmunity, cachingStrChargeImmunity))
+		return info.attacker->valOfBonuses(selectorJousting);
+	return 0;
 }
 
 double DamageCalculator::getAttackHateFactor() const
@@ -450,38 +461,63 @@ double DamageCalculator::getDefenseMindFactor() const
 	return 0.0;
 }
 
-std::vector<double> DamageCalculator::getAttackFactors() const
+std::vector<double> DamageCalculator::getAttackFactors(const DamageBaseFactors & factors) const
 {
 	return {
-		getAttackSkillFactor(),
-		getAttackOffenseArcheryFactor(),
-		getAttackBlessFactor(),
+		factors.attackSkill,
+		factors.attackOffenseArchery,
+		factors.attackBless,
 		getAttackLuckFactor(),
-		getAttackJoustingFactor(),
+		getAttackJoustingFactor(factors),
 		getAttackDeathBlowFactor(),
-		getAttackDoubleDamageFactor(),
-		getAttackHateFactor(),
+		getAttackDoubleDamageFactor(factors),
+		factors.attackHate,
 		getAttackRevengeFactor()
 	};
 }
 
-std::vector<double> DamageCalculator::getDefenseFactors() const
+std::vector<double> DamageCalculator::getDefenseFactors(const DamageBaseFactors & factors) const
 {
 	return {
-		getDefenseSkillFactor(),
-		getDefenseArmorerFactor(),
-		getDefenseMagicShieldFactor(),
+		factors.defenseSkill,
+		factors.defenseArmorer,
+		factors.defenseMagicShield,
 		getDefenseRangePenaltiesFactor(),
 		getDefenseObstacleFactor(),
-		getDefenseBlindParalysisFactor(),
+		factors.defenseBlindParalysis,
 		getDefenseUnluckyFactor(),
-		getDefenseForgetfulnessFactor(),
-		getDefensePetrificationFactor(),
-		getDefenseMagicFactor(),
-		getDefenseMindFactor()
+		factors.defenseForgetfulness,
+		factors.defensePetrification,
+		factors.defenseMagic,
+		factors.defenseMind
 	};
 }
 
+DamageBaseFactors DamageCalculator::calculateBaseFactors() const
+{
+	DamageBaseFactors factors;
+
+	factors.baseDamageSingle = getBaseDamageBlessCurse();
+
+	factors.attackSkill = getAttackSkillFactor();
+	factors.attackOffenseArchery = getAttackOffenseArcheryFactor();
+	factors.attackBless = getAttackBlessFactor();
+	factors.attackDoubleDamage = getAttackDoubleDamageValue();
+	factors.attackHate = getAttackHateFactor();
+	factors.attackJousting = getAttackJoustingValue();
+
+	factors.defenseSkill = getDefenseSkillFactor();
+	factors.defenseArmorer = getDefenseArmorerFactor();
+	factors.defenseMagicShield = getDefenseMagicShieldFactor();
+	factors.defenseBlindParalysis = getDefenseBlindParalysisFactor();
+	factors.defenseForgetfulness = getDefenseForgetfulnessFactor();
+	factors.defensePetrification = getDefensePetrificationFactor();
+	factors.defenseMagic = getDefenseMagicFactor();
+	factors.defenseMind = getDefenseMindFactor();
+
+	return factors;
+}
+
 DamageRange DamageCalculator::getCasualties(const DamageRange & damageDealt) const
 {
 	return {
@@ -514,10 +550,15 @@ int DamageCalculator::battleBonusValue(const IBonusBearer * bearer, const CSelec
 
 DamageEstimation DamageCalculator::calculateDmgRange() const
 {
-	DamageRange damageBase = getBaseDamageStack();
+	return calculateDmgRange(calculateBaseFactors());
+}
+
+DamageEstimation DamageCalculator::calculateDmgRange(const DamageBaseFactors & factors) const
+{
+	DamageRange damageBase = getBaseDamageStack(factors);
 
-	auto attackFactors = getAttackFactors();
-	auto defenseFactors = getDefenseFactors();
+	auto attackFactors = getAttackFactors(factors);
+	auto defenseFactors = getDefenseFactors(factors);
 
 	double attackFactorTotal = 1.0;
 	double defenseFactorTotal = 1.0;
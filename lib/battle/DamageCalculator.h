@@ -11,6 +11,7 @@
 #pragma once
 
 #include "../GameConstants.h"
+#include "IBattleInfoCallback.h"
 
 VCMI_LIB_NAMESPACE_BEGIN
 
@@ -18,8 +19,29 @@ class CBattleInfoCallback;
 class IBonusBearer;
 class CSelector;
 struct BattleAttackInfo;
-struct DamageRange;
-struct DamageEstimation;
+
+/// Parts of damage calculation that depend only on bonuses of attacker and defender and on attack type,
+/// but not on circumstances of particular attack such as luck, charge distance, positions or stack size
+struct DLL_LINKAGE DamageBaseFactors
+{
+	DamageRange baseDamageSingle;
+
+	double attackSkill = 0;
+	double attackOffenseArchery = 0;
+	double attackBless = 0;
+	double attackDoubleDamage = 0;
+	double attackHate = 0;
+	int attackJousting = 0;
+
+	double defenseSkill = 0;
+	double defenseArmorer = 0;
+	double defenseMagicShield = 0;
+	double defenseBlindParalysis = 0;
+	double defenseForgetfulness = 0;
+	double defensePetrification = 0;
+	double defenseMagic = 0;
+	double defenseMind = 0;
+};
 
 class DLL_LINKAGE DamageCalculator
 {
@@ -33,7 +55,7 @@ class DLL_LINKAGE DamageCalculator
 
 	DamageRange getBaseDamageSingle() const;
 	DamageRange getBaseDamageBlessCurse() const;
-	DamageRange getBaseDamageStack() const;
+	DamageRange getBaseDamageStack(const DamageBaseFactors & factors) const;
 
 	int getActorAttackBase() const;
 	int getActorAttackEffective() const;
@@ -47,9 +69,11 @@ class DLL_LINKAGE DamageCalculator
 	double getAttackOffenseArcheryFactor() const;
 	double getAttackBlessFactor() const;
 	double getAttackLuckFactor() const;
-	double getAttackJoustingFactor() const;
+	double getAttackJoustingFactor(const DamageBaseFactors & factors) const;
+	int getAttackJoustingValue() const;
 	double getAttackDeathBlowFactor() const;
-	double getAttackDoubleDamageFactor() const;
+	double getAttackDoubleDamageFactor(const DamageBaseFactors & factors) const;
+	double getAttackDoubleDamageValue() const;
 	double getAttackHateFactor() const;
 	double getAttackRevengeFactor() const;
 
@@ -65,15 +89,19 @@ class DLL_LINKAGE DamageCalculator
 	double getDefenseMagicFactor() const;
 	double getDefenseMindFactor() const;
 
-	std::vector<double> getAttackFactors() const;
-	std::vector<double> getDefenseFactors() const;
+	std::vector<double> getAttackFactors(const DamageBaseFactors & factors) const;
+	std::vector<double> getDefenseFactors(const DamageBaseFactors & factors) const;
 public:
 	DamageCalculator(const CBattleInfoCallback & callback, const BattleAttackInfo & info ):
 		callback(callback),
 		info(info)
 	{}
 
+	/// computes factors which can be reused for all attacks between same units while their bonuses remain unchanged
+	DamageBaseFactors calculateBaseFactors() const;
+
 	DamageEstimation calculateDmgRange() const;
+	DamageEstimation calculateDmgRange(const DamageBaseFactors & factors) const;
 };
 
 VCMI_LIB_NAMESPACE_END
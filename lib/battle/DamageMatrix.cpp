@@ -0,0 +1,77 @@
+/*
+ * DamageMatrix.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+
+#include "DamageMatrix.h"
+#include "BattleAttackInfo.h"
+#include "Unit.h"
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+DamageMatrix::DamageMatrix() = default;
+
+DamageMatrix::DamageMatrix(const DamageMatrix & other)
+	: DamageMatrix()
+{
+}
+
+DamageMatrix & DamageMatrix::operator=(const DamageMatrix & other)
+{
+	clear();
+	return *this;
+}
+
+DamageBaseFactors DamageMatrix::getFactors(const DamageCalculator & calculator, const BattleAttackInfo & info)
+{
+	const Key key(info.attacker->unitId(), info.defender->unitId(), info.shooting);
+
+	const int64_t attackerTreeVersion = info.attacker->getTreeVersion();
+	const int64_t defenderTreeVersion = info.defender->getTreeVersion();
+	const int32_t attackerCreature = info.attacker->creatureIndex();
+	const int32_t defenderCreature = info.defender->creatureIndex();
+
+	auto isValid = [&](const Entry & entry) -> bool
+	{
+		return entry.attackerTreeVersion == attackerTreeVersion
+			&& entry.defenderTreeVersion == defenderTreeVersion
+			&& entry.attackerCreature == attackerCreature
+			&& entry.defenderCreature == defenderCreature;
+	};
+
+	{
+		boost::shared_lock<boost::shared_mutex> lock(mx);
+
+		auto iter = entries.find(key);
+
+		if(iter != entries.end() && isValid(iter->second))
+		{
+			return iter->second.factors;
+		}
+	}
+
+	// calculation may take a while, do not block other readers meanwhile
+	Entry entry{attackerTreeVersion, defenderTreeVersion, attackerCreature, defenderCreature, calculator.calculateBaseFactors()};
+
+	boost::unique_lock<boost::shared_mutex> lock(mx);
+
+	entries[key] = entry;
+
+	return entry.factors;
+}
+
+void DamageMatrix::clear()
+{
+	boost::unique_lock<boost::shared_mutex> lock(mx);
+
+	entries.clear();
+}
+
+VCMI_LIB_NAMESPACE_END
@@ -0,0 +1,52 @@
+/*
+ * DamageMatrix.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include "DamageCalculator.h"
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+namespace battle
+{
+	class Unit;
+}
+
+/// Battle-scoped cache of base damage factors for every (attacker, defender, melee/ranged) combination.
+/// Entry is recomputed only when bonus tree version or creature of one of the units has changed,
+/// so repeated damage calculations skip most of bonus system queries.
+class DLL_LINKAGE DamageMatrix
+{
+	struct Entry
+	{
+		int64_t attackerTreeVersion;
+		int64_t defenderTreeVersion;
+		int32_t attackerCreature;
+		int32_t defenderCreature;
+		DamageBaseFactors factors;
+	};
+
+	using Key = std::tuple<uint32_t, uint32_t, bool>;
+
+	mutable boost::shared_mutex mx;
+	std::map<Key, Entry> entries;
+
+public:
+	DamageMatrix();
+
+	/// cached factors are bound to particular battle and are never copied
+	DamageMatrix(const DamageMatrix & other);
+	DamageMatrix & operator=(const DamageMatrix & other);
+
+	DamageBaseFactors getFactors(const DamageCalculator & calculator, const BattleAttackInfo & info);
+
+	void clear();
+};
+
+VCMI_LIB_NAMESPACE_END
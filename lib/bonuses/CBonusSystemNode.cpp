@@ -20,6 +20,19 @@ VCMI_LIB_NAMESPACE_BEGIN
 std::atomic<int64_t> CBonusSystemNode::treeChanged(1);
 constexpr bool CBonusSystemNode::cachingEnabled = true;
 
+namespace
+{
+	/// state of CBonusSystemNode::ChangesBatch, separate for every thread since server and client may share the process
+	struct ChangesBatchState
+	{
+		int depth = 0;
+		bool treeChangePending = false;
+		std::vector<CBonusSystemNode *> nodesToUpdate;
+	};
+
+	thread_local ChangesBatchState changesBatch;
+}
+
 std::shared_ptr<Bonus> CBonusSystemNode::getLocalBonus(const CSelector & selector)
 {
 	auto ret = bonuses.getFirst(selector);
@@ -112,6 +125,8 @@ TConstBonusListPtr CBonusSystemNode::getAllBonuses(const CSelector &selector, co
 	bool limitOnUs = (!root || root == this); //caching won't work when we want to limit bonuses against an external node
 	if (CBonusSystemNode::cachingEnabled && limitOnUs)
 	{
+		applyPendingTreeChange();
+
 		// Exclusive access for one thread
 		boost::lock_guard<boost::mutex> lock(sync);
 
@@ -223,6 +238,9 @@ CBonusSystemNode::CBonusSystemNode(ENodeTypes NodeType):
 
 CBonusSystemNode::~CBonusSystemNode()
 {
+	if(!changesBatch.nodesToUpdate.empty())
+		vstd::erase(changesBatch.nodesToUpdate, this);
+
 	detachFromAll();
 
 	if(!children.empty())
@@ -645,12 +663,53 @@ TBonusListPtr CBonusSystemNode::limitBonuses(const BonusList &allBonuses) const
 
 void CBonusSystemNode::treeHasChanged()
 {
-	treeChanged++;
+	if(changesBatch.depth > 0)
+		changesBatch.treeChangePending = true;
+	else
+		treeChanged++;
+}
+
+void CBonusSystemNode::applyPendingTreeChange()
+{
+	if(changesBatch.treeChangePending)
+	{
+		changesBatch.treeChangePending = false;
+		treeChanged++;
+	}
+}
+
+void CBonusSystemNode::deferUpdate()
+{
+	if(changesBatch.depth == 0)
+		deferredUpdate();
+	else if(!vstd::contains(changesBatch.nodesToUpdate, this))
+		changesBatch.nodesToUpdate.push_back(this);
 }
 
 int64_t CBonusSystemNode::getTreeVersion() const
 {
+	applyPendingTreeChange();
 	return treeChanged;
 }
 
+CBonusSystemNode::ChangesBatch::ChangesBatch()
+{
+	changesBatch.depth++;
+}
+
+CBonusSystemNode::ChangesBatch::~ChangesBatch()
+{
+	if(--changesBatch.depth > 0)
+		return;
+
+	// updated nodes may modify bonuses, which now invalidates tree immediately
+	while(!changesBatch.nodesToUpdate.empty())
+	{
+		CBonusSystemNode * node = changesBatch.nodesToUpdate.back();
+		changesBatch.nodesToUpdate.pop_back();
+		node->deferredUpdate();
+	}
+	applyPendingTreeChange();
+}
+
 VCMI_LIB_NAMESPACE_END
@@ -75,10 +75,15 @@ private:
 
 	void exportBonus(const std::shared_ptr<Bonus> & b);
 
+	static void applyPendingTreeChange();
+
 protected:
 	bool isIndependentNode() const; //node is independent when it has no parents nor children
 	void exportBonuses();
 
+	/// Recalculates state that depends on this node, see deferUpdate()
+	virtual void deferredUpdate() {}
+
 public:
 	explicit CBonusSystemNode(bool isHypotetic = false);
 	explicit CBonusSystemNode(ENodeTypes NodeType);
@@ -121,10 +126,23 @@ public:
 	void setNodeType(CBonusSystemNode::ENodeTypes type);
 	const TCNodesVector & getParentNodes() const;
 
+	/// Invalidates cached bonuses of all nodes. Inside of ChangesBatch invalidation is postponed until bonuses are queried or batch ends
 	static void treeHasChanged();
 
+	/// Requests call of deferredUpdate(). Inside of ChangesBatch update is performed once, when outermost batch ends
+	void deferUpdate();
+
 	int64_t getTreeVersion() const override;
 
+	/// Merges bonus tree changes made by current thread while batch exists
+	/// Used to apply series of changes, e.g. net packs, without recalculating bonuses for every intermediate state
+	class DLL_LINKAGE ChangesBatch : public boost::noncopyable
+	{
+	public:
+		ChangesBatch();
+		~ChangesBatch();
+	};
+
 	virtual PlayerColor getOwner() const
 	{
 		return PlayerColor::NEUTRAL;
@@ -56,7 +56,12 @@ std::unordered_set<ResourcePath> CMappedFileLoader::getFilteredFiles(std::functi
 	return foundID;
 }
 
+static std::atomic<uint64_t> lookupsCount(0);
+
 CFilesystemList::CFilesystemList()
+	: revision(1)
+	, indexRevision(0)
+	, parentList(nullptr)
 {
 }
 
@@ -64,25 +69,92 @@ CFilesystemList::~CFilesystemList()
 {
 }
 
+void CFilesystemList::invalidateIndex() const
+{
+	revision++;
+
+	if(parentList)
+		parentList->invalidateIndex();
+}
+
+void CFilesystemList::addToIndex(const ISimpleResourceLoader * loader) const
+{
+	const auto * list = dynamic_cast<const CFilesystemList *>(loader);
+
+	if(list)
+	{
+		for(const auto & nestedLoader : list->loaders)
+			addToIndex(nestedLoader.get());
+		return;
+	}
+
+	for(const auto & entry : loader->getFilteredFiles([](const ResourcePath &){ return true; }))
+		resourceIndex[entry].push_back(loader);
+}
+
+boost::shared_lock<boost::shared_mutex> CFilesystemList::lockIndex() const
+{
+	{
+		boost::shared_lock<boost::shared_mutex> lock(indexMutex);
+		if(indexRevision == revision)
+			return lock;
+	}
+
+	{
+		boost::unique_lock<boost::shared_mutex> lock(indexMutex);
+		uint32_t currentRevision = revision;
+
+		if(indexRevision != currentRevision)
+		{
+			resourceIndex.clear();
+			for(const auto & loader : loaders)
+				addToIndex(loader.get());
+			indexRevision = currentRevision;
+		}
+	}
+
+	return boost::shared_lock<boost::shared_mutex>(indexMutex);
+}
+
+const CFilesystemList::TLoadersList * CFilesystemList::findLoaders(const ResourcePath & resourceName) const
+{
+	lookupsCount++;
+
+	auto it = resourceIndex.find(resourceName);
+	if(it == resourceIndex.end())
+		return nullptr;
+	return &it->second;
+}
+
+uint64_t CFilesystemList::takeLookupsCount()
+{
+	return lookupsCount.exchange(0);
+}
+
 std::unique_ptr<CInputStream> CFilesystemList::load(const ResourcePath & resourceName) const
 {
-	// load resource from last loader that have it (last overridden version)
-	for(const auto & loader : boost::adaptors::reverse(loaders))
+	const ISimpleResourceLoader * loader = nullptr;
+
 	{
-		if (loader->existsResource(resourceName))
-			return loader->load(resourceName);
+		auto lock = lockIndex();
+		const auto * found = findLoaders(resourceName);
+
+		// load resource from last loader that have it (last overridden version)
+		if(found)
+			loader = found->back();
 	}
 
+	if(loader)
+		return loader->load(resourceName);
+
 	throw std::runtime_error("Resource with name " + resourceName.getName() + " and type "
 		+ EResTypeHelper::getEResTypeAsString(resourceName.getType()) + " wasn't found.");
 }
 
 bool CFilesystemList::existsResource(const ResourcePath & resourceName) const
 {
-	for(const auto & loader : loaders)
-		if (loader->existsResource(resourceName))
-			return true;
-	return false;
+	auto lock = lockIndex();
+	return findLoaders(resourceName) != nullptr;
 }
 
 std::string CFilesystemList::getMountPoint() const
@@ -92,8 +164,11 @@ std::string CFilesystemList::getMountPoint() const
 
 std::optional<boost::filesystem::path> CFilesystemList::getResourceName(const ResourcePath & resourceName) const
 {
-	if (existsResource(resourceName))
-		return getResourcesWithName(resourceName).back()->getResourceName(resourceName);
+	auto lock = lockIndex();
+	const auto * found = findLoaders(resourceName);
+
+	if (found)
+		return found->back()->getResourceName(resourceName);
 	return std::optional<boost::filesystem::path>();
 }
 
@@ -115,6 +190,8 @@ void CFilesystemList::updateFilteredFiles(std::function<bool(const std::string &
 {
 	for(const auto & loader : loaders)
 		loader->updateFilteredFiles(filter);
+
+	invalidateIndex();
 }
 
 std::unordered_set<ResourcePath> CFilesystemList::getFilteredFiles(std::function<bool(const ResourcePath &)> filter) const
@@ -139,6 +216,7 @@ bool CFilesystemList::createResource(const std::string & filename, bool update)
 			// Check if resource was created successfully. Possible reasons for this to fail
 			// a) loader failed to create resource (e.g. read-only FS)
 			// b) in update mode, call with filename that does not exists
+			invalidateIndex();
 			assert(load(ResourcePath(filename)));
 
 			logGlobal->trace("Resource created successfully");
@@ -151,12 +229,12 @@ bool CFilesystemList::createResource(const std::string & filename, bool update)
 
 std::vector<const ISimpleResourceLoader *> CFilesystemList::getResourcesWithName(const ResourcePath & resourceName) const
 {
-	std::vector<const ISimpleResourceLoader *> ret;
+	auto lock = lockIndex();
+	const auto * found = findLoaders(resourceName);
 
-	for(const auto & loader : loaders)
-		boost::range::copy(loader->getResourcesWithName(resourceName), std::back_inserter(ret));
-
-	return ret;
+	if(found)
+		return *found;
+	return {};
 }
 
 void CFilesystemList::addLoader(ISimpleResourceLoader * loader, bool writeable)
@@ -164,6 +242,12 @@ void CFilesystemList::addLoader(ISimpleResourceLoader * loader, bool writeable)
 	loaders.push_back(std::unique_ptr<ISimpleResourceLoader>(loader));
 	if (writeable)
 		writeableLoaders.insert(loader);
+
+	auto * list = dynamic_cast<CFilesystemList *>(loader);
+	if(list)
+		list->parentList = this;
+
+	invalidateIndex();
 }
 
 bool CFilesystemList::removeLoader(ISimpleResourceLoader * loader)
@@ -174,6 +258,7 @@ bool CFilesystemList::removeLoader(ISimpleResourceLoader * loader)
 		{
 			loaders.erase(loaderIterator);
 			writeableLoaders.erase(loader);
+			invalidateIndex();
 			return true;
 		}
 	}
@@ -55,14 +55,37 @@ private:
 
 class DLL_LINKAGE CFilesystemList : public ISimpleResourceLoader
 {
+	using TLoadersList = std::vector<const ISimpleResourceLoader *>;
+
 	std::vector<std::unique_ptr<ISimpleResourceLoader> > loaders;
 
 	std::set<ISimpleResourceLoader *> writeableLoaders;
 
+	/// All resources available in this list and all nested lists
+	/// value = all non-list loaders that contain this resource, in order of priority. Last loader overrides all others
+	mutable std::unordered_map<ResourcePath, TLoadersList> resourceIndex;
+	/// Incremented on every change in this list or in any of nested lists
+	mutable std::atomic<uint32_t> revision;
+	/// Revision of this list for which resource index was built
+	mutable uint32_t indexRevision;
+	mutable boost::shared_mutex indexMutex;
+
+	/// List to which this list was added, if any
+	CFilesystemList * parentList;
+
 	//FIXME: this is only compile fix, should be removed in the end
 	CFilesystemList(CFilesystemList &) = delete;
 	CFilesystemList &operator=(CFilesystemList &) = delete;
 
+	/// Invalidates resource index of this list and of all lists that contain it
+	void invalidateIndex() const;
+	/// Adds all resources from loader and from loaders nested in it into index
+	void addToIndex(const ISimpleResourceLoader * loader) const;
+	/// Rebuilds index if list has been modified since last rebuild and locks it for reading
+	boost::shared_lock<boost::shared_mutex> lockIndex() const;
+	/// Returns all loaders that have resource with such name, or nullptr if there are none. Index must be locked by caller
+	const TLoadersList * findLoaders(const ResourcePath & resourceName) const;
+
 public:
 	CFilesystemList();
 	~CFilesystemList();
@@ -96,6 +119,9 @@ public:
 	 * @return if loader was successfully removed
 	 */
 	bool removeLoader(ISimpleResourceLoader * loader);
+
+	/// Returns number of resource lookups in all lists since last call, and resets the counter
+	static uint64_t takeLookupsCount();
 };
 
 VCMI_LIB_NAMESPACE_END
@@ -13,11 +13,54 @@
 #include "VCMIDirs.h"
 #include "CFileInputStream.h"
 #include "CCompressedStream.h"
+#include "CMemoryStream.h"
 
 #include "CBinaryReader.h"
 
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
 VCMI_LIB_NAMESPACE_BEGIN
 
+struct ArchiveMapping
+{
+	boost::interprocess::file_mapping file;
+	boost::interprocess::mapped_region region;
+
+	explicit ArchiveMapping(const boost::filesystem::path & archive)
+		: file(archive.string().c_str(), boost::interprocess::read_only)
+		, region(file, boost::interprocess::read_only)
+	{
+	}
+
+	const ui8 * data() const
+	{
+		return static_cast<const ui8 *>(region.get_address());
+	}
+
+	size_t size() const
+	{
+		return region.get_size();
+	}
+};
+
+/// Stream that reads data from memory owned by another object, keeps owner alive while stream exists
+class CSharedMemoryStream : public CMemoryStream
+{
+	std::shared_ptr<const void> owner;
+
+public:
+	CSharedMemoryStream(std::shared_ptr<const void> owner, const ui8 * data, si64 size)
+		: CMemoryStream(data, size)
+		, owner(std::move(owner))
+	{
+	}
+};
+
+static std::atomic<si64> bytesRead(0);
+static std::atomic<si64> bytesInflated(0);
+static std::atomic<si64> cacheHits(0);
+
 ArchiveEntry::ArchiveEntry()
 	: offset(0), fullSize(0), compressedSize(0)
 {
@@ -27,7 +70,8 @@ ArchiveEntry::ArchiveEntry()
 CArchiveLoader::CArchiveLoader(std::string _mountPoint, boost::filesystem::path _archive, bool _extractArchives) :
     archive(std::move(_archive)),
     mountPoint(std::move(_mountPoint)),
-	extractArchives(_extractArchives)
+	extractArchives(_extractArchives),
+	inflatedCacheSize(0)
 {
 	// Open archive file(.snd, .vid, .lod)
 	CFileInputStream fileStream(archive);
@@ -36,6 +80,16 @@ CArchiveLoader::CArchiveLoader(std::string _mountPoint, boost::filesystem::path
 	if(fileStream.getSize() < 10)
 		return;
 
+	try
+	{
+		mapping = std::make_shared<ArchiveMapping>(archive);
+	}
+	catch(const boost::interprocess::interprocess_exception & e)
+	{
+		// not critical, e.g. lack of address space on 32-bit systems - use file streams instead
+		logGlobal->warn("Failed to map archive %s into memory: %s", archive.string(), e.what());
+	}
+
 	// Retrieve file extension of archive in uppercase
 	const std::string ext = boost::to_upper_copy(archive.extension().string());
 
@@ -169,20 +223,87 @@ void CArchiveLoader::initSNDArchive(const std::string &mountPoint, CFileInputStr
 	}
 }
 
+std::shared_ptr<ui8[]> CArchiveLoader::loadInflated(const ResourcePath & resourceName, const ArchiveEntry & entry) const
+{
+	{
+		boost::mutex::scoped_lock lock(inflatedCacheMutex);
+
+		auto it = inflatedCache.find(resourceName);
+		if(it != inflatedCache.end())
+		{
+			inflatedCacheOrder.splice(inflatedCacheOrder.begin(), inflatedCacheOrder, it->second.cachePosition);
+			cacheHits++;
+			return it->second.data;
+		}
+	}
+
+	auto compressedStream = std::make_unique<CMemoryStream>(mapping->data() + entry.offset, entry.compressedSize);
+	CCompressedStream inflatedStream(std::move(compressedStream), false, entry.fullSize);
+
+	std::shared_ptr<ui8[]> result(new ui8[entry.fullSize]());
+	inflatedStream.read(result.get(), entry.fullSize);
+
+	bytesRead += entry.compressedSize;
+	bytesInflated += entry.fullSize;
+
+	// entries that are larger than whole cache (e.g. videos) are not cached
+	if(static_cast<size_t>(entry.fullSize) > INFLATED_CACHE_SIZE)
+		return result;
+
+	boost::mutex::scoped_lock lock(inflatedCacheMutex);
+
+	// entry could have been loaded by another thread in the meantime
+	if(inflatedCache.count(resourceName))
+		return result;
+
+	inflatedCacheOrder.push_front(resourceName);
+	inflatedCache[resourceName] = { result, inflatedCacheOrder.begin() };
+	inflatedCacheSize += entry.fullSize;
+
+	while(inflatedCacheSize > INFLATED_CACHE_SIZE)
+	{
+		const auto & oldest = inflatedCacheOrder.back();
+		inflatedCacheSize -= entries.at(oldest).fullSize;
+		inflatedCache.erase(oldest);
+		inflatedCacheOrder.pop_back();
+	}
+
+	return result;
+}
+
 std::unique_ptr<CInputStream> CArchiveLoader::load(const ResourcePath & resourceName) const
 {
 	assert(existsResource(resourceName));
 
 	const ArchiveEntry & entry = entries.at(resourceName);
 
+	// entries that point outside of archive (e.g. in damaged files) are handled by file streams
+	size_t entryEnd = static_cast<size_t>(entry.offset) + (entry.compressedSize != 0 ? entry.compressedSize : entry.fullSize);
+
+	if (mapping && entryEnd <= mapping->size())
+	{
+		if (entry.compressedSize != 0) //compressed data
+		{
+			auto data = loadInflated(resourceName, entry);
+			return std::make_unique<CSharedMemoryStream>(data, data.get(), entry.fullSize);
+		}
+
+		bytesRead += entry.fullSize;
+		return std::make_unique<CSharedMemoryStream>(mapping, mapping->data() + entry.offset, entry.fullSize);
+	}
+
 	if (entry.compressedSize != 0) //compressed data
 	{
+		bytesRead += entry.compressedSize;
+		bytesInflated += entry.fullSize;
+
 		auto fileStream = std::make_unique<CFileInputStream>(archive, entry.offset, entry.compressedSize);
 
 		return std::make_unique<CCompressedStream>(std::move(fileStream), false, entry.fullSize);
 	}
 	else
 	{
+		bytesRead += entry.fullSize;
 		return std::make_unique<CFileInputStream>(archive, entry.offset, entry.fullSize);
 	}
 }
@@ -235,6 +356,15 @@ void CArchiveLoader::extractToFolder(const std::string & outputSubFolder, const
 	extractToFolder(outputSubFolder, *inputStream, entry);
 }
 
+ArchiveLoaderStatistics CArchiveLoader::getStatistics()
+{
+	ArchiveLoaderStatistics result;
+	result.bytesRead = bytesRead;
+	result.bytesInflated = bytesInflated;
+	result.cacheHits = cacheHits;
+	return result;
+}
+
 boost::filesystem::path createExtractedFilePath(const std::string & outputSubFolder, const std::string & entryName)
 {
 	boost::filesystem::path extractionFolderPath = VCMIDirs::get().userExtractedPath() / outputSubFolder;
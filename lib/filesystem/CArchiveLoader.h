@@ -15,6 +15,7 @@
 VCMI_LIB_NAMESPACE_BEGIN
 
 class CFileInputStream;
+struct ArchiveMapping;
 
 /**
  * A struct which holds information about the archive entry e.g. where it is located in space of the archive container.
@@ -39,6 +40,21 @@ struct ArchiveEntry
 	int compressedSize;
 };
 
+/**
+ * Counters of data loaded from all archives
+ */
+struct ArchiveLoaderStatistics
+{
+	/** Bytes read from archive files, compressed size for compressed entries **/
+	si64 bytesRead = 0;
+
+	/** Bytes produced by decompression of compressed entries **/
+	si64 bytesInflated = 0;
+
+	/** Number of compressed entries loaded from cache without decompression **/
+	si64 cacheHits = 0;
+};
+
 /**
  * A class which can scan and load files of a LOD archive.
  */
@@ -70,7 +86,22 @@ public:
 	/** Extracts one archive entry to the specified subfolder. Used for Images, Sprites, etc */
 	void extractToFolder(const std::string & outputSubFolder, const std::string & mountPoint, ArchiveEntry entry) const;
 
+	/** Returns counters of data loaded from all archives since start of the program **/
+	static ArchiveLoaderStatistics getStatistics();
+
 private:
+	struct InflatedEntry
+	{
+		std::shared_ptr<ui8[]> data;
+		std::list<ResourcePath>::iterator cachePosition;
+	};
+
+	/** Maximal total size of decompressed entries that are kept in cache, per archive **/
+	static constexpr size_t INFLATED_CACHE_SIZE = 16 * 1024 * 1024;
+
+	/** Returns decompressed data of entry, either from cache or by decompressing it from mapped archive **/
+	std::shared_ptr<ui8[]> loadInflated(const ResourcePath & resourceName, const ArchiveEntry & entry) const;
+
 	/**
 	 * Initializes a LOD archive.
 	 *
@@ -102,6 +133,15 @@ private:
 
 	/** Specifies if Original H3 archives should be extracted to a separate folder **/
 	bool extractArchives;
+
+	/** Archive file mapped into memory, or nullptr if mapping has failed and entries are read using file streams **/
+	std::shared_ptr<const ArchiveMapping> mapping;
+
+	/** Decompressed entries, most recently used entries are in front of the list **/
+	mutable std::unordered_map<ResourcePath, InflatedEntry> inflatedCache;
+	mutable std::list<ResourcePath> inflatedCacheOrder;
+	mutable size_t inflatedCacheSize;
+	mutable boost::mutex inflatedCacheMutex;
 };
 
 /** Constructs the file path for the extracted file. Creates the subfolder hierarchy aswell **/
@@ -695,19 +695,16 @@ void CGameState::initFogOfWar()
 	for(auto & elem : teams)
 	{
 		auto & fow = elem.second.fogOfWarMap;
-		fow->resize(boost::extents[layers][map->width][map->height]);
-		std::fill(fow->data(), fow->data() + fow->num_elements(), 0);
+		fow.resize(int3(map->width, map->height, layers));
 
 		for(CGObjectInstance *obj : map->objects)
 		{
 			if(!obj || !vstd::contains(elem.second.players, obj->tempOwner)) continue; //not a flagged object
 
-			std::unordered_set<int3> tiles;
-			getTilesInRange(tiles, obj->getSightCenter(), obj->getSightRadius(), ETileVisibility::HIDDEN, obj->tempOwner);
-			for(const int3 & tile : tiles)
-			{
-				(*elem.second.fogOfWarMap)[tile.z][tile.x][tile.y] = 1;
-			}
+			if(obj->getSightRadius() == CBuilding::HEIGHT_SKYSHIP) //reveal entire map
+				fow.resize(fow.size(), true);
+			else
+				fow.reveal(obj->getSightCenter(), obj->getSightRadius());
 		}
 	}
 }
@@ -975,6 +972,7 @@ void CGameState::initMapObjects()
 	CGSubterraneanGate::postInit(callback); //pairing subterranean gates
 
 	map->calculateGuardingGreaturePositions(); //calculate once again when all the guards are placed and initialized
+	map->calculateTileFlags();
 }
 
 void CGameState::placeHeroesInTowns()
@@ -1166,6 +1164,7 @@ PlayerRelations CGameState::getPlayerRelations( PlayerColor color1, PlayerColor
 
 void CGameState::apply(CPack *pack)
 {
+	CBonusSystemNode::ChangesBatch changesBatch;
 	ui16 typ = CTypeList::getInstance().getTypeID(pack);
 	applier->getApplier(typ)->applyOnGS(this, pack);
 }
@@ -1325,7 +1324,7 @@ bool CGameState::isVisible(int3 pos, const std::optional<PlayerColor> & player)
 	if(player->isSpectator())
 		return true;
 
-	return (*getPlayerTeam(*player)->fogOfWarMap)[pos.z][pos.x][pos.y];
+	return getPlayerTeam(*player)->fogOfWarMap.isVisible(pos);
 }
 
 bool CGameState::isVisible(const CGObjectInstance * obj, const std::optional<PlayerColor> & player) const
@@ -1956,7 +1955,6 @@ bool RumorState::update(int id, int extra)
 TeamState::TeamState()
 {
 	setNodeType(TEAM);
-	fogOfWarMap = std::make_unique<boost::multi_array<ui8, 3>>();
 }
 
 CRandomGenerator & CGameState::getRandomGenerator()
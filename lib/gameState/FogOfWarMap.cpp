@@ -0,0 +1,195 @@
+/*
+ * FogOfWarMap.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "FogOfWarMap.h"
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+FogOfWarMap::FogOfWarMap() = default;
+
+FogOfWarMap::FogOfWarMap(const int3 & size, bool visible)
+{
+	resize(size, visible);
+}
+
+void FogOfWarMap::resize(const int3 & size, bool visible)
+{
+	sizes = size;
+	wordsPerRow = (size.x + WORD_BITS - 1) / WORD_BITS;
+	words.assign(static_cast<size_t>(wordsPerRow) * size.y * size.z, 0);
+
+	if(visible)
+	{
+		for(int z = 0; z < sizes.z; z++)
+			for(int y = 0; y < sizes.y; y++)
+				setSpan(0, sizes.x - 1, y, z);
+	}
+}
+
+const int3 & FogOfWarMap::size() const
+{
+	return sizes;
+}
+
+void FogOfWarMap::setVisible(const int3 & tile, bool visible)
+{
+	assert(tile.x >= 0 && tile.y >= 0 && tile.z >= 0 && tile.x < sizes.x && tile.y < sizes.y && tile.z < sizes.z);
+
+	Word & word = words[rowOffset(tile.y, tile.z) + tile.x / WORD_BITS];
+	Word mask = Word(1) << (tile.x % WORD_BITS);
+
+	if(visible)
+		word |= mask;
+	else
+		word &= ~mask;
+}
+
+void FogOfWarMap::setVisible(const std::unordered_set<int3> & tiles, bool visible)
+{
+	for(const int3 & tile : tiles)
+		setVisible(tile, visible);
+}
+
+void FogOfWarMap::setSpan(int x0, int x1, int y, int z)
+{
+	Word * row = words.data() + rowOffset(y, z);
+
+	int firstWord = x0 / WORD_BITS;
+	int lastWord = x1 / WORD_BITS;
+
+	for(int i = firstWord; i <= lastWord; i++)
+	{
+		int from = i == firstWord ? x0 % WORD_BITS : 0;
+		int to = i == lastWord ? x1 % WORD_BITS : WORD_BITS - 1;
+
+		Word mask = ~Word(0) >> (WORD_BITS - 1 - to + from) << from;
+		row[i] |= mask;
+	}
+}
+
+int FogOfWarMap::rangeHalfWidth(int dy, int radius, int3::EDistanceFormula formula)
+{
+	dy = std::abs(dy);
+
+	if(radius < 0 || dy > radius)
+		return -1;
+
+	auto maxRoot = [](int64_t value) -> int
+	{
+		if(value < 0)
+			return -1;
+		auto result = static_cast<int64_t>(std::sqrt(static_cast<double>(value)));
+		while(result * result > value)
+			result--;
+		while((result + 1) * (result + 1) <= value)
+			result++;
+		return static_cast<int>(result);
+	};
+
+	switch(formula)
+	{
+		case int3::DIST_2D:
+			// round(sqrt(d)) <= radius is same as d <= radius * radius + radius for integer d
+			return maxRoot(static_cast<int64_t>(radius) * radius + radius - static_cast<int64_t>(dy) * dy);
+		case int3::DIST_MANHATTAN:
+			return radius - dy;
+		case int3::DIST_CHEBYSHEV:
+			return radius;
+		case int3::DIST_2DSQ:
+			return maxRoot(static_cast<int64_t>(radius) - static_cast<int64_t>(dy) * dy);
+		default:
+			return -1;
+	}
+}
+
+void FogOfWarMap::reveal(const int3 & center, int radius, int3::EDistanceFormula formula)
+{
+	if(center.z < 0 || center.z >= sizes.z)
+		return;
+
+	// larger radius covers whole level anyway and may overflow coordinates
+	radius = std::min(radius, sizes.x + sizes.y);
+
+	for(int y = std::max(center.y - radius, 0); y <= std::min(center.y + radius, sizes.y - 1); y++)
+	{
+		int halfWidth = rangeHalfWidth(y - center.y, radius, formula);
+		int x0 = std::max(center.x - halfWidth, 0);
+		int x1 = std::min(center.x + halfWidth, sizes.x - 1);
+
+		if(halfWidth >= 0 && x0 <= x1)
+			setSpan(x0, x1, y, center.z);
+	}
+}
+
+void FogOfWarMap::reveal(const FogOfWarMap & other)
+{
+	assert(sizes == other.sizes);
+
+	for(size_t i = 0; i < words.size(); i++)
+		words[i] |= other.words[i];
+}
+
+void FogOfWarMap::getTiles(std::unordered_set<int3> & tiles, bool visible) const
+{
+	for(int z = 0; z < sizes.z; z++)
+	{
+		for(int y = 0; y < sizes.y; y++)
+		{
+			const Word * row = words.data() + rowOffset(y, z);
+
+			for(int i = 0; i < wordsPerRow; i++)
+			{
+				Word matching = visible ? row[i] : ~row[i];
+
+				for(int x = i * WORD_BITS; matching != 0 && x < sizes.x; x++, matching >>= 1)
+				{
+					if(matching & 1)
+						tiles.insert(int3(x, y, z));
+				}
+			}
+		}
+	}
+}
+
+std::vector<FogOfWarRun> FogOfWarMap::encodeRuns(const std::unordered_set<int3> & tiles)
+{
+	std::vector<int3> sorted(tiles.begin(), tiles.end());
+	std::sort(sorted.begin(), sorted.end(), [](const int3 & a, const int3 & b)
+	{
+		return std::tie(a.z, a.y, a.x) < std::tie(b.z, b.y, b.x);
+	});
+
+	std::vector<FogOfWarRun> result;
+
+	for(const int3 & tile : sorted)
+	{
+		if(!result.empty())
+		{
+			FogOfWarRun & last = result.back();
+
+			if(last.start.z == tile.z && last.start.y == tile.y && last.start.x + last.length == tile.x && last.length < std::numeric_limits<ui16>::max())
+			{
+				last.length++;
+				continue;
+			}
+		}
+		result.push_back({tile, 1});
+	}
+	return result;
+}
+
+void FogOfWarMap::decodeRuns(const std::vector<FogOfWarRun> & runs, std::unordered_set<int3> & tiles)
+{
+	for(const auto & run : runs)
+		for(int i = 0; i < run.length; i++)
+			tiles.insert(int3(run.start.x + i, run.start.y, run.start.z));
+}
+
+VCMI_LIB_NAMESPACE_END
@@ -0,0 +1,107 @@
+/*
+ * FogOfWarMap.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include "../int3.h"
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+/// Horizontal run of tiles, used to transfer sets of tiles in compact form
+struct DLL_LINKAGE FogOfWarRun
+{
+	int3 start;
+	ui16 length = 0;
+
+	template <typename Handler> void serialize(Handler & h)
+	{
+		h & start;
+		h & length;
+	}
+};
+
+/// Visibility of map tiles for one team, stored as one bit per tile
+/// Every map row is padded to whole words, so ranges of tiles within a row can be updated one word at a time
+class DLL_LINKAGE FogOfWarMap
+{
+	using Word = ui64;
+	static constexpr int WORD_BITS = 64;
+
+	int3 sizes;
+	int wordsPerRow = 0;
+	std::vector<Word> words;
+
+	size_t rowOffset(int y, int z) const
+	{
+		return (static_cast<size_t>(z) * sizes.y + y) * wordsPerRow;
+	}
+
+	void setSpan(int x0, int x1, int y, int z);
+
+public:
+	FogOfWarMap();
+	explicit FogOfWarMap(const int3 & size, bool visible = false);
+
+	/// resizes map to specified dimensions, with all tiles set to specified visibility
+	void resize(const int3 & size, bool visible = false);
+	const int3 & size() const;
+
+	bool isVisible(const int3 & tile) const
+	{
+		assert(tile.x >= 0 && tile.y >= 0 && tile.z >= 0 && tile.x < sizes.x && tile.y < sizes.y && tile.z < sizes.z);
+		return (words[rowOffset(tile.y, tile.z) + tile.x / WORD_BITS] >> (tile.x % WORD_BITS)) & 1;
+	}
+
+	void setVisible(const int3 & tile, bool visible);
+	void setVisible(const std::unordered_set<int3> & tiles, bool visible);
+
+	/// makes visible all tiles within radius from center
+	void reveal(const int3 & center, int radius, int3::EDistanceFormula formula = int3::DIST_2D);
+	/// makes visible all tiles that are visible in other map of same size
+	void reveal(const FogOfWarMap & other);
+
+	/// returns all tiles with specified visibility
+	void getTiles(std::unordered_set<int3> & tiles, bool visible) const;
+
+	/// returns largest distance along X axis from center of range to tiles in row located dy rows away, or -1 if row is outside of range
+	static int rangeHalfWidth(int dy, int radius, int3::EDistanceFormula formula);
+
+	/// converts set of tiles into runs and back
+	static std::vector<FogOfWarRun> encodeRuns(const std::unordered_set<int3> & tiles);
+	static void decodeRuns(const std::vector<FogOfWarRun> & runs, std::unordered_set<int3> & tiles);
+
+	/// serializes set of tiles in form of runs
+	template <typename Handler> static void serializeTiles(Handler & h, std::unordered_set<int3> & tiles)
+	{
+		if (h.version < Handler::Version::PACKED_FOG_OF_WAR)
+		{
+			h & tiles;
+			return;
+		}
+
+		std::vector<FogOfWarRun> runs;
+		if (h.saving)
+			runs = encodeRuns(tiles);
+		h & runs;
+		if (!h.saving)
+		{
+			tiles.clear();
+			decodeRuns(runs, tiles);
+		}
+	}
+
+	template <typename Handler> void serialize(Handler & h)
+	{
+		h & sizes;
+		h & wordsPerRow;
+		h & words;
+	}
+};
+
+VCMI_LIB_NAMESPACE_END
@@ -0,0 +1,303 @@
+/*
+ * JsonDocument.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+#include "JsonDocument.h"
+
+#include "JsonParser.h"
+#include "filesystem/Filesystem.h"
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+JsonDocument::Value::Value()
+	: integer(0)
+{
+}
+
+JsonDocument::JsonDocument() = default;
+
+JsonDocument::JsonDocument(const std::byte * data, size_t datasize)
+	: JsonDocument(data, datasize, JsonParsingSettings())
+{
+}
+
+JsonDocument::JsonDocument(const std::byte * data, size_t datasize, const JsonParsingSettings & parserSettings)
+{
+	JsonParser parser(data, datasize, parserSettings);
+	*this = parser.parseDocument("<unknown>");
+}
+
+JsonDocument::JsonDocument(const JsonPath & fileURI)
+{
+	auto file = CResourceHandler::get()->load(fileURI)->readAll();
+
+	JsonParser parser(reinterpret_cast<std::byte *>(file.first.get()), file.second, JsonParsingSettings());
+	*this = parser.parseDocument(fileURI.getName());
+}
+
+JsonDocument::JsonDocument(const JsonPath & fileURI, const std::string & idx)
+{
+	auto file = CResourceHandler::get(idx)->load(fileURI)->readAll();
+
+	JsonParser parser(reinterpret_cast<std::byte *>(file.first.get()), file.second, JsonParsingSettings());
+	*this = parser.parseDocument(fileURI.getName());
+}
+
+JsonView JsonDocument::root() const
+{
+	if(values.empty())
+		return JsonView();
+	return JsonView(this, 0);
+}
+
+const std::string & JsonDocument::getModScope() const
+{
+	return modScope;
+}
+
+void JsonDocument::setModScope(const std::string & metadata)
+{
+	modScope = metadata;
+}
+
+bool JsonDocument::isValid() const
+{
+	return valid;
+}
+
+JsonView::Iterator::Iterator(const JsonDocument * document, uint32_t member, bool structEntries)
+	: document(document)
+	, member(member)
+	, structEntries(structEntries)
+{
+}
+
+JsonView JsonView::Iterator::operator*() const
+{
+	return JsonView(document, document->members[member].value);
+}
+
+std::string_view JsonView::Iterator::key() const
+{
+	if(!structEntries)
+		return {};
+	return document->keys[document->members[member].key];
+}
+
+bool JsonView::Iterator::getOverrideFlag() const
+{
+	return document->members[member].overrideFlag;
+}
+
+JsonView::Iterator & JsonView::Iterator::operator++()
+{
+	++member;
+	return *this;
+}
+
+bool JsonView::Iterator::operator==(const Iterator & other) const
+{
+	return document == other.document && member == other.member;
+}
+
+bool JsonView::Iterator::operator!=(const Iterator & other) const
+{
+	return !(*this == other);
+}
+
+JsonView::JsonView()
+	: document(nullptr)
+	, index(0)
+{
+}
+
+JsonView::JsonView(const JsonDocument * document, uint32_t index)
+	: document(document)
+	, index(index)
+{
+}
+
+JsonNode::JsonType JsonView::getType() const
+{
+	if(!document)
+		return JsonNode::JsonType::DATA_NULL;
+	return document->values[index].type;
+}
+
+bool JsonView::isNull() const
+{
+	return getType() == JsonNode::JsonType::DATA_NULL;
+}
+
+bool JsonView::isNumber() const
+{
+	return getType() == JsonNode::JsonType::DATA_INTEGER || getType() == JsonNode::JsonType::DATA_FLOAT;
+}
+
+bool JsonView::isString() const
+{
+	return getType() == JsonNode::JsonType::DATA_STRING;
+}
+
+bool JsonView::isVector() const
+{
+	return getType() == JsonNode::JsonType::DATA_VECTOR;
+}
+
+bool JsonView::isStruct() const
+{
+	return getType() == JsonNode::JsonType::DATA_STRUCT;
+}
+
+bool JsonView::Bool() const
+{
+	assert(getType() == JsonNode::JsonType::DATA_NULL || getType() == JsonNode::JsonType::DATA_BOOL);
+
+	if(getType() == JsonNode::JsonType::DATA_BOOL)
+		return document->values[index].boolean;
+
+	return false;
+}
+
+double JsonView::Float() const
+{
+	assert(getType() == JsonNode::JsonType::DATA_NULL || getType() == JsonNode::JsonType::DATA_INTEGER || getType() == JsonNode::JsonType::DATA_FLOAT);
+
+	if(getType() == JsonNode::JsonType::DATA_FLOAT)
+		return document->values[index].floating;
+
+	if(getType() == JsonNode::JsonType::DATA_INTEGER)
+		return static_cast<double>(document->values[index].integer);
+
+	return 0;
+}
+
+si64 JsonView::Integer() const
+{
+	assert(getType() == JsonNode::JsonType::DATA_NULL || getType() == JsonNode::JsonType::DATA_INTEGER || getType() == JsonNode::JsonType::DATA_FLOAT);
+
+	if(getType() == JsonNode::JsonType::DATA_INTEGER)
+		return document->values[index].integer;
+
+	if(getType() == JsonNode::JsonType::DATA_FLOAT)
+		return static_cast<si64>(document->values[index].floating);
+
+	return 0;
+}
+
+std::string_view JsonView::String() const
+{
+	assert(getType() == JsonNode::JsonType::DATA_NULL || getType() == JsonNode::JsonType::DATA_STRING);
+
+	if(getType() == JsonNode::JsonType::DATA_STRING)
+	{
+		const auto & value = document->values[index];
+		return std::string_view(document->strings.data() + value.offset, value.size);
+	}
+
+	return {};
+}
+
+size_t JsonView::size() const
+{
+	if(isVector() || isStruct())
+		return document->values[index].size;
+	return 0;
+}
+
+JsonView::Iterator JsonView::begin() const
+{
+	if(size() == 0)
+		return Iterator(document, 0, false);
+	return Iterator(document, document->values[index].offset, isStruct());
+}
+
+JsonView::Iterator JsonView::end() const
+{
+	if(size() == 0)
+		return Iterator(document, 0, false);
+	return Iterator(document, document->values[index].offset + document->values[index].size, isStruct());
+}
+
+JsonView JsonView::operator[](std::string_view child) const
+{
+	assert(getType() == JsonNode::JsonType::DATA_NULL || getType() == JsonNode::JsonType::DATA_STRUCT);
+
+	if(!isStruct())
+		return JsonView();
+
+	const auto & value = document->values[index];
+	auto first = document->members.begin() + value.offset;
+	auto last = first + value.size;
+
+	// entries of structs are sorted by key on loading
+	auto it = std::lower_bound(first, last, child, [this](const JsonDocument::Member & member, std::string_view key)
+	{
+		return document->keys[member.key] < key;
+	});
+
+	if(it != last && document->keys[it->key] == child)
+		return JsonView(document, it->value);
+	return JsonView();
+}
+
+JsonView JsonView::operator[](size_t child) const
+{
+	assert(getType() == JsonNode::JsonType::DATA_NULL || getType() == JsonNode::JsonType::DATA_VECTOR);
+
+	if(!isVector() || child >= size())
+		return JsonView();
+
+	return JsonView(document, document->members[document->values[index].offset + child].value);
+}
+
+JsonNode JsonView::toJsonNode() const
+{
+	JsonNode result;
+	result.setType(getType());
+
+	switch(getType())
+	{
+		case JsonNode::JsonType::DATA_NULL:
+			break;
+		case JsonNode::JsonType::DATA_BOOL:
+			result.Bool() = Bool();
+			break;
+		case JsonNode::JsonType::DATA_FLOAT:
+			result.Float() = Float();
+			break;
+		case JsonNode::JsonType::DATA_INTEGER:
+			result.Integer() = Integer();
+			break;
+		case JsonNode::JsonType::DATA_STRING:
+			result.String() = std::string(String());
+			break;
+		case JsonNode::JsonType::DATA_VECTOR:
+			result.Vector().reserve(size());
+			for(auto it = begin(); it != end(); ++it)
+				result.Vector().push_back((*it).toJsonNode());
+			break;
+		case JsonNode::JsonType::DATA_STRUCT:
+			for(auto it = begin(); it != end(); ++it)
+			{
+				JsonNode & member = result.Struct()[std::string(it.key())];
+				member = (*it).toJsonNode();
+				member.setOverrideFlag(it.getOverrideFlag());
+			}
+			break;
+	}
+
+	if(document)
+		result.setModScope(document->getModScope(), false);
+
+	return result;
+}
+
+VCMI_LIB_NAMESPACE_END
@@ -0,0 +1,149 @@
+/*
+ * JsonDocument.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include "JsonNode.h"
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+class JsonDocument;
+
+/// Lightweight read-only reference to a single value inside JsonDocument
+/// Provides same const accessors as JsonNode. Must not outlive its document
+class DLL_LINKAGE JsonView
+{
+	const JsonDocument * document;
+	uint32_t index;
+
+public:
+	/// Iterates over elements of vector or over values of struct
+	class DLL_LINKAGE Iterator
+	{
+		const JsonDocument * document;
+		uint32_t member;
+		bool structEntries;
+
+	public:
+		Iterator(const JsonDocument * document, uint32_t member, bool structEntries);
+
+		JsonView operator*() const;
+		/// Key of current element, empty string for vectors
+		std::string_view key() const;
+		/// Value of override flag specified in key of current element
+		bool getOverrideFlag() const;
+
+		Iterator & operator++();
+		bool operator==(const Iterator & other) const;
+		bool operator!=(const Iterator & other) const;
+	};
+
+	/// Creates view to null value
+	JsonView();
+	JsonView(const JsonDocument * document, uint32_t index);
+
+	JsonNode::JsonType getType() const;
+
+	bool isNull() const;
+	bool isNumber() const;
+	bool isString() const;
+	bool isVector() const;
+	bool isStruct() const;
+
+	/// accessors, will cause assertion failure on type mismatch
+	bool Bool() const;
+	///float and integer allowed
+	double Float() const;
+	///only integer allowed
+	si64 Integer() const;
+	std::string_view String() const;
+
+	/// number of elements in vector or struct, 0 for all other types
+	size_t size() const;
+	Iterator begin() const;
+	Iterator end() const;
+
+	/// for structs only - get child node by name, null view if there is no such child
+	JsonView operator[](std::string_view child) const;
+	/// for vectors only - get child node by index, null view if index is out of range
+	JsonView operator[](size_t child) const;
+
+	/// converts this value and all its children into independent JsonNode tree
+	JsonNode toJsonNode() const;
+};
+
+/// Read-only json document stored in few flat arrays instead of tree of individually allocated nodes
+/// All strings are stored in single buffer, keys of structs are interned and entries of structs are sorted by key
+/// Intended for bulk reading of large json files, use JsonNode for data that needs to be modified
+class DLL_LINKAGE JsonDocument
+{
+	friend class JsonView;
+	friend class JsonDocumentBuilder;
+	friend class JsonParser;
+
+	struct Value
+	{
+		JsonNode::JsonType type = JsonNode::JsonType::DATA_NULL;
+		/// length of string or number of entries in vector or struct
+		uint32_t size = 0;
+		union
+		{
+			bool boolean;
+			double floating;
+			si64 integer;
+			/// position of first character in strings or of first entry in members
+			uint32_t offset;
+		};
+
+		Value();
+	};
+
+	struct Member
+	{
+		/// index of key in keys, unused for vectors
+		uint32_t key;
+		/// index of value in values
+		uint32_t value;
+		bool overrideFlag;
+	};
+
+	/// All values of document, root is always first
+	std::vector<Value> values;
+	/// Entries of all vectors and structs, entries of each container are placed contiguously
+	std::vector<Member> members;
+	/// Content of all string values
+	std::string strings;
+	/// Interned keys of all structs
+	std::vector<std::string> keys;
+
+	std::string modScope;
+	bool valid = true;
+
+public:
+	JsonDocument();
+
+	/// Create document from Json-formatted input
+	explicit JsonDocument(const std::byte * data, size_t datasize);
+	explicit JsonDocument(const std::byte * data, size_t datasize, const JsonParsingSettings & parserSettings);
+
+	/// Create document from JSON file
+	explicit JsonDocument(const JsonPath & fileURI);
+	explicit JsonDocument(const JsonPath & fileURI, const std::string & modName);
+
+	JsonView root() const;
+
+	/// Mod-origin of whole document
+	const std::string & getModScope() const;
+	void setModScope(const std::string & metadata);
+
+	/// returns true if input was parsed without any errors or warnings
+	bool isValid() const;
+};
+
+VCMI_LIB_NAMESPACE_END
@@ -13,10 +13,260 @@
 
 #include "../ScopeGuard.h"
 #include "../TextOperations.h"
+#include "JsonDocument.h"
 #include "JsonFormatException.h"
 
 VCMI_LIB_NAMESPACE_BEGIN
 
+/// Builds tree of JsonNode's
+class JsonNodeBuilder
+{
+public:
+	using Node = JsonNode *;
+
+	void setNull(Node node)
+	{
+		node->clear();
+	}
+
+	void setBool(Node node, bool value)
+	{
+		node->Bool() = value;
+	}
+
+	void setInteger(Node node, si64 value)
+	{
+		node->setType(JsonNode::JsonType::DATA_INTEGER);
+		node->Integer() = value;
+	}
+
+	void setFloat(Node node, double value)
+	{
+		node->setType(JsonNode::JsonType::DATA_FLOAT);
+		node->Float() = value;
+	}
+
+	void setString(Node node, std::string & value)
+	{
+		node->setType(JsonNode::JsonType::DATA_STRING);
+		node->String() = std::move(value);
+	}
+
+	void beginStruct(Node node)
+	{
+		node->setType(JsonNode::JsonType::DATA_STRUCT);
+	}
+
+	Node addMember(Node node, const std::string & key, bool overrideFlag, bool & duplicate)
+	{
+		duplicate = node->Struct().find(key) != node->Struct().end();
+
+		JsonNode & member = node->Struct()[key];
+		member.setOverrideFlag(overrideFlag);
+		return &member;
+	}
+
+	void endStruct(Node node)
+	{
+	}
+
+	void beginVector(Node node)
+	{
+		node->setType(JsonNode::JsonType::DATA_VECTOR);
+	}
+
+	Node addElement(Node node)
+	{
+		//NOTE: currently 50% of time is this vector resizing.
+		//May be useful to use list during parsing and then swap() all items to vector
+		node->Vector().emplace_back();
+		return &node->Vector().back();
+	}
+
+	void endVector(Node node)
+	{
+	}
+
+	void finish()
+	{
+	}
+};
+
+/// Builds flat JsonDocument. Entries of containers are collected in temporary stack
+/// and moved into document once container has been fully parsed
+class JsonDocumentBuilder
+{
+	struct PendingContainer
+	{
+		uint32_t node;
+		size_t firstMember;
+	};
+
+	JsonDocument & document;
+	std::unordered_map<std::string, uint32_t> keyIndices;
+	std::vector<JsonDocument::Member> pendingMembers;
+	std::vector<PendingContainer> pendingContainers;
+
+	JsonDocument::Value & value(uint32_t node)
+	{
+		return document.values[node];
+	}
+
+	uint32_t addValue()
+	{
+		document.values.emplace_back();
+		return static_cast<uint32_t>(document.values.size() - 1);
+	}
+
+	uint32_t internKey(const std::string & key)
+	{
+		auto it = keyIndices.find(key);
+		if(it != keyIndices.end())
+			return it->second;
+
+		auto index = static_cast<uint32_t>(document.keys.size());
+		document.keys.push_back(key);
+		keyIndices[key] = index;
+		return index;
+	}
+
+	void beginContainer(uint32_t node, JsonNode::JsonType type)
+	{
+		size_t firstMember = pendingMembers.size();
+
+		// same as JsonNode - container under duplicated key is merged into previous container of the same type
+		if(value(node).type == type)
+		{
+			auto first = document.members.begin() + value(node).offset;
+			pendingMembers.insert(pendingMembers.end(), first, first + value(node).size);
+		}
+
+		value(node).type = type;
+		pendingContainers.push_back({node, firstMember});
+	}
+
+	void endContainer()
+	{
+		const auto & container = pendingContainers.back();
+		auto first = pendingMembers.begin() + container.firstMember;
+		auto & result = value(container.node);
+
+		if(result.type == JsonNode::JsonType::DATA_STRUCT)
+		{
+			std::sort(first, pendingMembers.end(), [this](const JsonDocument::Member & left, const JsonDocument::Member & right)
+			{
+				return document.keys[left.key] < document.keys[right.key];
+			});
+		}
+
+		result.offset = static_cast<uint32_t>(document.members.size());
+		result.size = static_cast<uint32_t>(pendingMembers.end() - first);
+		document.members.insert(document.members.end(), first, pendingMembers.end());
+
+		pendingMembers.erase(first, pendingMembers.end());
+		pendingContainers.pop_back();
+	}
+
+public:
+	using Node = uint32_t;
+
+	explicit JsonDocumentBuilder(JsonDocument & document)
+		: document(document)
+	{
+	}
+
+	Node addRoot()
+	{
+		return addValue();
+	}
+
+	void setNull(Node node)
+	{
+		value(node).type = JsonNode::JsonType::DATA_NULL;
+	}
+
+	void setBool(Node node, bool newValue)
+	{
+		value(node).type = JsonNode::JsonType::DATA_BOOL;
+		value(node).boolean = newValue;
+	}
+
+	void setInteger(Node node, si64 newValue)
+	{
+		value(node).type = JsonNode::JsonType::DATA_INTEGER;
+		value(node).integer = newValue;
+	}
+
+	void setFloat(Node node, double newValue)
+	{
+		value(node).type = JsonNode::JsonType::DATA_FLOAT;
+		value(node).floating = newValue;
+	}
+
+	void setString(Node node, std::string & newValue)
+	{
+		value(node).type = JsonNode::JsonType::DATA_STRING;
+		value(node).offset = static_cast<uint32_t>(document.strings.size());
+		value(node).size = static_cast<uint32_t>(newValue.size());
+		document.strings += newValue;
+	}
+
+	void beginStruct(Node node)
+	{
+		beginContainer(node, JsonNode::JsonType::DATA_STRUCT);
+	}
+
+	Node addMember(Node node, const std::string & key, bool overrideFlag, bool & duplicate)
+	{
+		uint32_t keyIndex = internKey(key);
+
+		duplicate = false;
+		for(auto it = pendingMembers.begin() + pendingContainers.back().firstMember; it != pendingMembers.end(); ++it)
+		{
+			if(it->key == keyIndex)
+			{
+				// same as JsonNode - duplicated entry is parsed into existing value
+				duplicate = true;
+				it->overrideFlag = overrideFlag;
+				return it->value;
+			}
+		}
+
+		uint32_t member = addValue();
+		pendingMembers.push_back({keyIndex, member, overrideFlag});
+		return member;
+	}
+
+	void endStruct(Node node)
+	{
+		endContainer();
+	}
+
+	void beginVector(Node node)
+	{
+		beginContainer(node, JsonNode::JsonType::DATA_VECTOR);
+	}
+
+	Node addElement(Node node)
+	{
+		uint32_t element = addValue();
+		pendingMembers.push_back({0, element, false});
+		return element;
+	}
+
+	void endVector(Node node)
+	{
+		endContainer();
+	}
+
+	/// closes all containers that were left unfinished due to parsing error
+	void finish()
+	{
+		while(!pendingContainers.empty())
+			endContainer();
+	}
+};
+
 JsonParser::JsonParser(const std::byte * inputString, size_t stringSize, const JsonParsingSettings & settings)
 	: settings(settings)
 	, input(reinterpret_cast<const char *>(inputString), stringSize)
@@ -27,10 +277,9 @@ JsonParser::JsonParser(const std::byte * inputString, size_t stringSize, const J
 {
 }
 
-JsonNode JsonParser::parse(const std::string & fileName)
+template<typename Builder>
+void JsonParser::extractRoot(Builder & builder, typename Builder::Node root, const std::string & fileName)
 {
-	JsonNode root;
-
 	if(input.empty())
 	{
 		error("File is empty", false);
@@ -45,7 +294,7 @@ JsonNode JsonParser::parse(const std::string & fileName)
 		if (firstCharacter == 0xFEFF)
 			pos += TextOperations::getUnicodeCharacterSize(input[0]);
 
-		extractValue(root);
+		extractValue(builder, root);
 		extractWhitespace(false);
 
 		//Warn if there are any non-whitespace symbols left
@@ -53,14 +302,32 @@ JsonNode JsonParser::parse(const std::string & fileName)
 			error("Not all file was parsed!", true);
 	}
 
+	builder.finish();
+
 	if(!errors.empty())
 	{
 		logMod->warn("File %s is not a valid JSON file!", fileName);
 		logMod->warn(errors);
 	}
+}
+
+JsonNode JsonParser::parse(const std::string & fileName)
+{
+	JsonNode root;
+	JsonNodeBuilder builder;
+	extractRoot(builder, &root, fileName);
 	return root;
 }
 
+JsonDocument JsonParser::parseDocument(const std::string & fileName)
+{
+	JsonDocument document;
+	JsonDocumentBuilder builder(document);
+	extractRoot(builder, builder.addRoot(), fileName);
+	document.valid = isValid();
+	return document;
+}
+
 bool JsonParser::isValid()
 {
 	return errors.empty();
@@ -78,7 +345,8 @@ bool JsonParser::extractSeparator()
 	return true;
 }
 
-bool JsonParser::extractValue(JsonNode & node)
+template<typename Builder>
+bool JsonParser::extractValue(Builder & builder, typename Builder::Node node)
 {
 	if(!extractWhitespace())
 		return false;
@@ -87,25 +355,25 @@ bool JsonParser::extractValue(JsonNode & node)
 	{
 		case '\"':
 		case '\'':
-			return extractString(node);
+			return extractString(builder, node);
 		case 'n':
-			return extractNull(node);
+			return extractNull(builder, node);
 		case 't':
-			return extractTrue(node);
+			return extractTrue(builder, node);
 		case 'f':
-			return extractFalse(node);
+			return extractFalse(builder, node);
 		case '{':
-			return extractStruct(node);
+			return extractStruct(builder, node);
 		case '[':
-			return extractArray(node);
+			return extractArray(builder, node);
 		case '-':
 		case '+':
 		case '.':
-			return extractFloat(node);
+			return extractFloat(builder, node);
 		default:
 		{
 			if(input[pos] >= '0' && input[pos] <= '9')
-				return extractFloat(node);
+				return extractFloat(builder, node);
 			return error("Value expected!");
 		}
 	}
@@ -241,14 +509,14 @@ bool JsonParser::extractString(std::string & str)
 	return error("Unterminated string!");
 }
 
-bool JsonParser::extractString(JsonNode & node)
+template<typename Builder>
+bool JsonParser::extractString(Builder & builder, typename Builder::Node node)
 {
 	std::string str;
 	if(!extractString(str))
 		return false;
 
-	node.setType(JsonNode::JsonType::DATA_STRING);
-	node.String() = str;
+	builder.setString(node, str);
 	return true;
 }
 
@@ -285,36 +553,40 @@ bool JsonParser::extractAndCompareLiteral(const std::string & expectedLiteral)
 	return true;
 }
 
-bool JsonParser::extractNull(JsonNode & node)
+template<typename Builder>
+bool JsonParser::extractNull(Builder & builder, typename Builder::Node node)
 {
 	if(!extractAndCompareLiteral("null"))
 		return false;
 
-	node.clear();
+	builder.setNull(node);
 	return true;
 }
 
-bool JsonParser::extractTrue(JsonNode & node)
+template<typename Builder>
+bool JsonParser::extractTrue(Builder & builder, typename Builder::Node node)
 {
 	if(!extractAndCompareLiteral("true"))
 		return false;
 
-	node.Bool() = true;
+	builder.setBool(node, true);
 	return true;
 }
 
-bool JsonParser::extractFalse(JsonNode & node)
+template<typename Builder>
+bool JsonParser::extractFalse(Builder & builder, typename Builder::Node node)
 {
 	if(!extractAndCompareLiteral("false"))
 		return false;
 
-	node.Bool() = false;
+	builder.setBool(node, false);
 	return true;
 }
 
-bool JsonParser::extractStruct(JsonNode & node)
+template<typename Builder>
+bool JsonParser::extractStruct(Builder & builder, typename Builder::Node node)
 {
-	node.setType(JsonNode::JsonType::DATA_STRUCT);
+	builder.beginStruct(node);
 
 	if(currentDepth > settings.maxDepth)
 		error("Maximum allowed depth of json structure has been reached", true);
@@ -333,6 +605,7 @@ bool JsonParser::extractStruct(JsonNode & node)
 	if(input[pos] == '}')
 	{
 		pos++;
+		builder.endStruct(node);
 		return true;
 	}
 
@@ -380,26 +653,29 @@ bool JsonParser::extractStruct(JsonNode & node)
 			}
 		}
 
-		if(node.Struct().find(key) != node.Struct().end())
+		bool duplicate = false;
+		auto member = builder.addMember(node, key, overrideFlag, duplicate);
+
+		if(duplicate)
 			error("Duplicate element encountered!", true);
 
 		if(!extractSeparator())
 			return false;
 
-		if(!extractElement(node.Struct()[key], '}'))
+		if(!extractElement(builder, member, '}'))
 			return false;
 
-		node.Struct()[key].setOverrideFlag(overrideFlag);
-
 		if(input[pos] == '}')
 		{
 			pos++;
+			builder.endStruct(node);
 			return true;
 		}
 	}
 }
 
-bool JsonParser::extractArray(JsonNode & node)
+template<typename Builder>
+bool JsonParser::extractArray(Builder & builder, typename Builder::Node node)
 {
 	if(currentDepth > settings.maxDepth)
 		error("Macimum allowed depth of json structure has been reached", true);
@@ -411,7 +687,7 @@ bool JsonParser::extractArray(JsonNode & node)
 	});
 
 	pos++;
-	node.setType(JsonNode::JsonType::DATA_VECTOR);
+	builder.beginVector(node);
 
 	if(!extractWhitespace())
 		return false;
@@ -420,29 +696,28 @@ bool JsonParser::extractArray(JsonNode & node)
 	if(input[pos] == ']')
 	{
 		pos++;
+		builder.endVector(node);
 		return true;
 	}
 
 	while(true)
 	{
-		//NOTE: currently 50% of time is this vector resizing.
-		//May be useful to use list during parsing and then swap() all items to vector
-		node.Vector().resize(node.Vector().size() + 1);
-
-		if(!extractElement(node.Vector().back(), ']'))
+		if(!extractElement(builder, builder.addElement(node), ']'))
 			return false;
 
 		if(input[pos] == ']')
 		{
 			pos++;
+			builder.endVector(node);
 			return true;
 		}
 	}
 }
 
-bool JsonParser::extractElement(JsonNode & node, char terminator)
+template<typename Builder>
+bool JsonParser::extractElement(Builder & builder, typename Builder::Node node, char terminator)
 {
-	if(!extractValue(node))
+	if(!extractValue(builder, node))
 		return false;
 
 	if(!extractWhitespace())
@@ -470,7 +745,8 @@ bool JsonParser::extractElement(JsonNode & node, char terminator)
 	return true;
 }
 
-bool JsonParser::extractFloat(JsonNode & node)
+template<typename Builder>
+bool JsonParser::extractFloat(Builder & builder, typename Builder::Node node)
 {
 	//TODO: JSON5 - hexacedimal support
 	//TODO: JSON5 - Numbers may be IEEE 754 positive infinity, negative infinity, and NaN (why?)
@@ -564,16 +840,14 @@ bool JsonParser::extractFloat(JsonNode & node)
 		if(negative)
 			result = -result;
 
-		node.setType(JsonNode::JsonType::DATA_FLOAT);
-		node.Float() = result;
+		builder.setFloat(node, result);
 	}
 	else
 	{
 		if(negative)
 			integerPart = -integerPart;
 
-		node.setType(JsonNode::JsonType::DATA_INTEGER);
-		node.Integer() = integerPart;
+		builder.setInteger(node, integerPart);
 	}
 
 	return true;
@@ -13,6 +13,8 @@
 
 VCMI_LIB_NAMESPACE_BEGIN
 
+class JsonDocument;
+
 //Internal class for string -> JsonNode conversion
 class JsonParser
 {
@@ -32,17 +34,29 @@ class JsonParser
 	bool extractString(std::string & string);
 	bool extractWhitespace(bool verbose = true);
 	bool extractSeparator();
-	bool extractElement(JsonNode & node, char terminator);
+	template<typename Builder>
+	bool extractElement(Builder & builder, typename Builder::Node node, char terminator);
 
 	//Methods for extracting JSON data
-	bool extractArray(JsonNode & node);
-	bool extractFalse(JsonNode & node);
-	bool extractFloat(JsonNode & node);
-	bool extractNull(JsonNode & node);
-	bool extractString(JsonNode & node);
-	bool extractStruct(JsonNode & node);
-	bool extractTrue(JsonNode & node);
-	bool extractValue(JsonNode & node);
+	template<typename Builder>
+	bool extractArray(Builder & builder, typename Builder::Node node);
+	template<typename Builder>
+	bool extractFalse(Builder & builder, typename Builder::Node node);
+	template<typename Builder>
+	bool extractFloat(Builder & builder, typename Builder::Node node);
+	template<typename Builder>
+	bool extractNull(Builder & builder, typename Builder::Node node);
+	template<typename Builder>
+	bool extractString(Builder & builder, typename Builder::Node node);
+	template<typename Builder>
+	bool extractStruct(Builder & builder, typename Builder::Node node);
+	template<typename Builder>
+	bool extractTrue(Builder & builder, typename Builder::Node node);
+	template<typename Builder>
+	bool extractValue(Builder & builder, typename Builder::Node node);
+
+	template<typename Builder>
+	void extractRoot(Builder & builder, typename Builder::Node root, const std::string & fileName);
 
 	//Add error\warning message to list
 	bool error(const std::string & message, bool warning = false);
@@ -53,6 +67,9 @@ public:
 	/// do actual parsing. filename is name of file that will printed to console if any errors were found
 	JsonNode parse(const std::string & fileName);
 
+	/// same as parse, but produces read-only flat document instead of node tree
+	JsonDocument parseDocument(const std::string & fileName);
+
 	/// returns true if parsing was successful
 	bool isValid();
 };
@@ -146,16 +146,36 @@ static std::string typeCheck(JsonValidator & validator, const JsonNode & baseSch
 
 static std::string refCheck(JsonValidator & validator, const JsonNode & baseSchema, const JsonNode & schema, const JsonNode & data)
 {
-	std::string URI = schema.String();
-	//node must be validated using schema pointed by this reference and not by data here
-	//Local reference. Turn it into more easy to handle remote ref
-	if (boost::algorithm::starts_with(URI, "#"))
+	struct ResolvedReference
 	{
-		const std::string name = validator.usedSchemas.back();
-		const std::string nameClean = name.substr(0, name.find('#'));
-		URI = nameClean + URI;
+		std::string URI;
+		const JsonNode * target;
+	};
+
+	// reference node always belongs to same schema file, so it always resolves into same target
+	static std::unordered_map<const JsonNode *, ResolvedReference> resolvedReferences;
+
+	auto it = resolvedReferences.find(&schema);
+	if (it == resolvedReferences.end())
+	{
+		std::string URI = schema.String();
+		//node must be validated using schema pointed by this reference and not by data here
+		//Local reference. Turn it into more easy to handle remote ref
+		if (boost::algorithm::starts_with(URI, "#"))
+		{
+			const std::string name = validator.usedSchemas.back();
+			const std::string nameClean = name.substr(0, name.find('#'));
+			URI = nameClean + URI;
+		}
+		it = resolvedReferences.emplace(&schema, ResolvedReference{URI, &JsonUtils::getSchema(URI)}).first;
 	}
-	return validator.check(URI, data);
+
+	validator.usedSchemas.push_back(it->second.URI);
+	auto onscopeExit = vstd::makeScopeGuard([&validator]()
+	{
+		validator.usedSchemas.pop_back();
+	});
+	return validator.check(*it->second.target, data);
 }
 
 static std::string formatCheck(JsonValidator & validator, const JsonNode & baseSchema, const JsonNode & schema, const JsonNode & data)
@@ -624,16 +644,66 @@ std::string JsonValidator::check(const std::string & schemaName, const JsonNode
 	return check(JsonUtils::getSchema(schemaName), data);
 }
 
-std::string JsonValidator::check(const JsonNode & schema, const JsonNode & data)
+/// Schema node with fields that are known for each type of data already looked up
+/// Fields that do not need any checks are excluded
+struct CompiledSchema
 {
-	const TValidatorMap & knownFields = getKnownFieldsFor(data.getType());
-	std::string errors;
-	for(const auto & entry : schema.Struct())
+	using TCheck = std::pair<const JsonValidator::TFieldValidator *, const JsonNode *>;
+
+	/// list of checks for each type of data, indexed by JsonNode::JsonType
+	std::array<std::vector<TCheck>, 7> checks;
+};
+
+static const CompiledSchema & compileSchema(JsonValidator & validator, const JsonNode & schema)
+{
+	static std::unordered_map<const JsonNode *, CompiledSchema> compiledSchemas;
+
+	auto it = compiledSchemas.find(&schema);
+	if (it != compiledSchemas.end())
+		return it->second;
+
+	using TCheckFunction = std::string(*)(JsonValidator &, const JsonNode &, const JsonNode &, const JsonNode &);
+
+	static const std::vector<JsonNode::JsonType> dataTypes = {
+		JsonNode::JsonType::DATA_NULL,
+		JsonNode::JsonType::DATA_BOOL,
+		JsonNode::JsonType::DATA_FLOAT,
+		JsonNode::JsonType::DATA_STRING,
+		JsonNode::JsonType::DATA_VECTOR,
+		JsonNode::JsonType::DATA_STRUCT,
+		JsonNode::JsonType::DATA_INTEGER
+	};
+
+	CompiledSchema & compiled = compiledSchemas[&schema];
+
+	for (const auto & type : dataTypes)
 	{
-		auto checker = knownFields.find(entry.first);
-		if (checker != knownFields.end())
-			errors += checker->second(*this, schema, entry.second, data);
+		const auto & knownFields = validator.getKnownFieldsFor(type);
+		auto & checks = compiled.checks[static_cast<size_t>(type)];
+
+		for(const auto & entry : schema.Struct())
+		{
+			auto checker = knownFields.find(entry.first);
+			if (checker == knownFields.end())
+				continue;
+
+			const auto * function = checker->second.target<TCheckFunction>();
+			if (function && *function == emptyCheck)
+				continue;
+
+			checks.emplace_back(&checker->second, &entry.second);
+		}
 	}
+	return compiled;
+}
+
+std::string JsonValidator::check(const JsonNode & schema, const JsonNode & data)
+{
+	const CompiledSchema & compiled = compileSchema(*this, schema);
+
+	std::string errors;
+	for(const auto & check : compiled.checks[static_cast<size_t>(data.getType())])
+		errors += (*check.first)(*this, schema, *check.second, data);
 	return errors;
 }
 
@@ -36,7 +36,10 @@ struct JsonValidator
 	const TValidatorMap & getKnownFieldsFor(JsonNode::JsonType type);
 	const TFormatMap & getKnownFormats();
 
+	/// Validates data against schema loaded from config/schemas
 	std::string check(const std::string & schemaName, const JsonNode & data);
+	/// Validates data against schema node. Schema must remain valid for lifetime of program
+	/// since it is compiled on first use and compiled form is reused by all following validations
 	std::string check(const JsonNode & schema, const JsonNode & data);
 };
 
@@ -143,6 +143,12 @@ void CArmedInstance::updateMoraleBonusFromArmy()
 }
 
 void CArmedInstance::armyChanged()
+{
+	// series of stack changes within one pack updates morale only once
+	deferUpdate();
+}
+
+void CArmedInstance::deferredUpdate()
 {
 	updateMoraleBonusFromArmy();
 }
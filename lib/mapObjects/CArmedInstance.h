@@ -26,6 +26,9 @@ private:
 	CCheckProxy nonEvilAlignmentMix;
 	static CSelector nonEvilAlignmentMixSelector;
 
+protected:
+	void deferredUpdate() override;
+
 public:
 	BattleInfo *battle; //set to the current battle, if engaged
 
@@ -218,9 +218,44 @@ void CMap::removeBlockVisTiles(CGObjectInstance * obj, bool total)
 					curt.blockingObjects -= obj;
 					curt.blocked = curt.blockingObjects.size();
 				}
+				updateTileFlags(int3(xVal, yVal, zVal));
 			}
 		}
 	}
+	objectIndex.remove(obj);
+}
+
+void CMap::updateTileFlags(const int3 & tile)
+{
+	const TerrainTile & t = getTile(tile);
+	ui8 flags = 0;
+
+	if(t.terType)
+	{
+		if(t.terType->isPassable())
+			flags |= ETileFlag::PASSABLE;
+		if(t.terType->isWater())
+			flags |= ETileFlag::WATER;
+		if(t.terType->isLand())
+			flags |= ETileFlag::LAND;
+	}
+	if(t.visitable)
+		flags |= ETileFlag::VISITABLE;
+	if(t.blocked)
+		flags |= ETileFlag::BLOCKED;
+
+	tileFlags[(tile.z * width + tile.x) * height + tile.y] = flags;
+}
+
+void CMap::calculateTileFlags()
+{
+	tileFlags.resize(levels() * width * height);
+
+	int3 pos;
+	for(pos.z = 0; pos.z < levels(); ++pos.z)
+		for(pos.x = 0; pos.x < width; ++pos.x)
+			for(pos.y = 0; pos.y < height; ++pos.y)
+				updateTileFlags(pos);
 }
 
 void CMap::addBlockVisTiles(CGObjectInstance * obj)
@@ -245,9 +280,40 @@ void CMap::addBlockVisTiles(CGObjectInstance * obj)
 					curt.blockingObjects.push_back(obj);
 					curt.blocked = true;
 				}
+				updateTileFlags(int3(xVal, yVal, zVal));
 			}
 		}
 	}
+	objectIndex.add(obj);
+}
+
+const MapObjectIndex & CMap::getObjectIndex() const
+{
+	return objectIndex;
+}
+
+void CMap::calculateObjectIndex()
+{
+	objectIndex.resize(int3(width, height, levels()));
+
+	for(CGObjectInstance * obj : objects)
+	{
+		if(!obj)
+			continue;
+
+		auto blockedTiles = obj->getBlockedPos();
+
+		// objects without blocked or visitable tiles, such as holes, are always on map
+		bool placed = blockedTiles.empty() && !obj->isVisitable();
+
+		for(const int3 & tile : blockedTiles)
+			placed |= isInTheMap(tile) && vstd::contains(getTile(tile).blockingObjects, obj);
+		if(obj->isVisitable() && isInTheMap(obj->visitablePos()))
+			placed |= vstd::contains(getTile(obj->visitablePos()).visitableObjects, obj);
+
+		if(placed)
+			objectIndex.add(obj);
+	}
 }
 
 void CMap::calculateGuardingGreaturePositions()
@@ -677,6 +743,8 @@ void CMap::initTerrain()
 {
 	terrain.resize(boost::extents[levels()][width][height]);
 	guardingCreaturePositions.resize(boost::extents[levels()][width][height]);
+	tileFlags.assign(levels() * width * height, 0);
+	objectIndex.resize(int3(width, height, levels()));
 }
 
 CMapEditManager * CMap::getEditManager()
@@ -12,6 +12,7 @@
 
 #include "CMapDefines.h"
 #include "CMapHeader.h"
+#include "MapObjectIndex.h"
 
 #include "../ConstTransitivePtr.h"
 #include "../GameCallbackHolder.h"
@@ -92,8 +93,21 @@ public:
 	bool checkForVisitableDir(const int3 & src, const TerrainTile * pom, const int3 & dst) const;
 	int3 guardingCreaturePosition (int3 pos) const;
 
+	/// Returns packed properties of tile, see ETileFlag. Much cheaper than getTile for traversal of whole map
+	ui8 getTileFlags(const int3 & tile) const
+	{
+		return tileFlags[(tile.z * width + tile.x) * height + tile.y];
+	}
+	/// Updates packed properties of tile, must be called after any change of its terrain type
+	void updateTileFlags(const int3 & tile);
+	void calculateTileFlags();
+
 	void addBlockVisTiles(CGObjectInstance * obj);
 	void removeBlockVisTiles(CGObjectInstance * obj, bool total = false);
+
+	/// Returns spatial index of all objects currently placed on map
+	const MapObjectIndex & getObjectIndex() const;
+	void calculateObjectIndex();
 	void calculateGuardingGreaturePositions();
 
 	void addNewArtifactInstance(ConstTransitivePtr<CArtifactInstance> art);
@@ -169,6 +183,10 @@ public:
 private:
 	/// a 3-dimensional array of terrain tiles, access is as follows: x, y, level. where level=1 is underground
 	boost::multi_array<TerrainTile, 3> terrain;
+	/// packed properties of all tiles, in the same order as terrain. Not serialized, calculated from terrain on loading
+	std::vector<ui8> tileFlags;
+	/// Not serialized, calculated from terrain and objects on loading
+	MapObjectIndex objectIndex;
 
 	si32 uidCounter; //TODO: initialize when loading an old map
 
@@ -200,6 +218,9 @@ public:
 		h & terrain;
 		h & guardingCreaturePositions;
 
+		if(!h.saving)
+			calculateTileFlags();
+
 		h & objects;
 		h & heroesOnMap;
 		h & teleportChannels;
@@ -213,6 +234,9 @@ public:
 		h & townUniversitySkills;
 
 		h & instanceNames;
+
+		if(!h.saving)
+			calculateObjectIndex();
 	}
 };
 
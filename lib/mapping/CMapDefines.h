@@ -78,6 +78,19 @@ public:
 	void serializeJson(JsonSerializeFormat & handler) override;
 };
 
+/// Properties of a tile that CMap additionally stores packed into a single byte per tile, see CMap::getTileFlags
+namespace ETileFlag
+{
+	enum ETileFlag : ui8
+	{
+		PASSABLE = 1 << 0,
+		WATER = 1 << 1,
+		LAND = 1 << 2,
+		VISITABLE = 1 << 3,
+		BLOCKED = 1 << 4
+	};
+}
+
 /// The terrain tile describes the terrain type and the visual representation of the terrain.
 /// Furthermore the struct defines whether the tile is visitable or/and blocked and which objects reside in it.
 struct DLL_LINKAGE TerrainTile
@@ -150,7 +150,13 @@ void CMapHeader::registerMapStrings()
 	
 	if(maxStrings == 0 || mapLanguages.empty())
 	{
-		logGlobal->trace("Map %s doesn't have any supported translation", name.toString());
+		// name is not translated here, headers may be loaded in parallel with strings of other maps
+		if(logGlobal->isTraceEnabled())
+		{
+			JsonNode nameIdentifier;
+			name.jsonSerialize(nameIdentifier);
+			logGlobal->trace("Map %s doesn't have any supported translation", nameIdentifier.toCompactString());
+		}
 		return;
 	}
 	
@@ -44,12 +44,17 @@ CMapInfo::~CMapInfo()
 
 void CMapInfo::mapInit(const std::string & fname)
 {
-	fileURI = fname;
 	CMapService mapService;
+	mapInit(fname, mapService.loadMapHeader(ResourcePath(fname, EResType::MAP)));
+}
+
+void CMapInfo::mapInit(const std::string & fname, std::unique_ptr<CMapHeader> header)
+{
+	fileURI = fname;
 	ResourcePath resource = ResourcePath(fname, EResType::MAP);
 	originalFileURI = resource.getOriginalName();
 	fullFileURI = boost::filesystem::canonical(*CResourceHandler::get()->getResourceName(resource)).string();
-	mapHeader = mapService.loadMapHeader(resource);
+	mapHeader = std::move(header);
 	countPlayers();
 }
 
@@ -47,6 +47,8 @@ public:
 	CMapInfo &operator=(const CMapInfo &other) = delete;
 
 	void mapInit(const std::string & fname);
+	/// initializes info using map header that was already loaded, e.g. by CMapService::loadMapHeaders
+	void mapInit(const std::string & fname, std::unique_ptr<CMapHeader> header);
 	void saveInit(const ResourcePath & file);
 	void campaignInit();
 	void countPlayers();
@@ -261,6 +261,9 @@ void CDrawTerrainOperation::updateTerrainViews()
 {
 	for(const auto & pos : invalidatedTerViews)
 	{
+		// all tiles with changed terrain type are also invalidated
+		map->updateTileFlags(pos);
+
 		const auto & patterns = VLC->terviewh->getTerrainViewPatterns(map->getTile(pos).terType->getId());
 
 		// Detect a pattern which fits best
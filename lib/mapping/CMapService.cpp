@@ -19,8 +19,12 @@
 #include "../modding/CModHandler.h"
 #include "../modding/ModScope.h"
 #include "../modding/CModInfo.h"
+#include "../CThreadHelper.h"
 #include "../Languages.h"
+#include "../VCMIDirs.h"
 #include "../VCMI_Lib.h"
+#include "../serializer/CLoadFile.h"
+#include "../serializer/CSaveFile.h"
 
 #include "CMap.h"
 #include "MapFormat.h"
@@ -74,6 +78,144 @@ std::unique_ptr<CMapHeader> CMapService::loadMapHeader(const uint8_t * buffer, i
 	return header;
 }
 
+static const std::string MAP_HEADERS_CACHE_MAGIC = "VCMIMHC";
+
+/// Header of a single map in map headers cache, along with modification time of map file it was loaded from
+struct MapHeaderCacheEntry
+{
+	int64_t lastWrite = 0;
+	CMapHeader header;
+
+	template <typename Handler> void serialize(Handler & h)
+	{
+		h & lastWrite;
+		h & header;
+	}
+};
+
+using MapHeaderCache = std::map<std::string, MapHeaderCacheEntry>;
+
+static boost::filesystem::path getMapHeadersCachePath()
+{
+	return VCMIDirs::get().userCachePath() / "mapHeaders.vcmi";
+}
+
+/// Checksum of all active mods. Headers depend on loaded mods, e.g. via list of allowed heroes, so any change in mods invalidates whole cache
+static ui32 getActiveModsChecksum()
+{
+	boost::crc_32_type result;
+	for(const auto & modName : VLC->modh->getActiveMods())
+	{
+		ui32 modChecksum = VLC->modh->getModInfo(modName).getVerificationInfo().checksum;
+		result.process_bytes(modName.data(), modName.size());
+		result.process_bytes(&modChecksum, sizeof(modChecksum));
+	}
+	return result.checksum();
+}
+
+static MapHeaderCache loadMapHeadersCache(ui32 modsChecksum)
+{
+	const auto path = getMapHeadersCachePath();
+	MapHeaderCache cache;
+
+	if(!boost::filesystem::exists(path))
+		return cache;
+
+	try
+	{
+		// throws if cache was written by different version of serializer
+		CLoadFile file(path);
+		file.checkMagicBytes(MAP_HEADERS_CACHE_MAGIC);
+
+		ui32 checksum = 0;
+		file >> checksum;
+
+		if(checksum == modsChecksum)
+			file >> cache;
+	}
+	catch(const std::exception & e)
+	{
+		logGlobal->warn("Failed to load map headers cache: %s", e.what());
+		cache.clear();
+	}
+	return cache;
+}
+
+static void saveMapHeadersCache(ui32 modsChecksum, const MapHeaderCache & cache)
+{
+	const auto path = getMapHeadersCachePath();
+
+	try
+	{
+		CSaveFile file(path);
+		file.putMagicBytes(MAP_HEADERS_CACHE_MAGIC);
+		file << modsChecksum;
+		file << cache;
+	}
+	catch(const std::exception & e)
+	{
+		logGlobal->warn("Failed to save map headers cache: %s", e.what());
+		boost::filesystem::remove(path);
+	}
+}
+
+std::vector<std::unique_ptr<CMapHeader>> CMapService::loadMapHeaders(const std::vector<ResourcePath> & names) const
+{
+	const ui32 modsChecksum = getActiveModsChecksum();
+	MapHeaderCache oldCache = loadMapHeadersCache(modsChecksum);
+	MapHeaderCache newCache;
+	boost::mutex cacheMutex;
+
+	std::vector<std::unique_ptr<CMapHeader>> result(names.size());
+	std::vector<CThreadHelper::Task> tasks;
+	std::atomic<int> cacheHits = 0;
+
+	for(size_t i = 0; i < names.size(); ++i)
+	{
+		tasks.push_back([&, i]()
+		{
+			const auto & name = names[i];
+
+			try
+			{
+				auto fullPath = CResourceHandler::get()->getResourceName(name);
+				int64_t lastWrite = fullPath ? static_cast<int64_t>(boost::filesystem::last_write_time(*fullPath)) : 0;
+				std::string key = fullPath ? fullPath->string() : name.getName();
+
+				auto cached = oldCache.find(key);
+				if(cached != oldCache.end() && cached->second.lastWrite == lastWrite)
+				{
+					result[i] = std::make_unique<CMapHeader>(cached->second.header);
+					cacheHits++;
+				}
+				else
+				{
+					// only header is read, gzip stream of h3m maps is decompressed lazily up to the end of header
+					result[i] = loadMapHeader(name);
+				}
+
+				boost::mutex::scoped_lock lock(cacheMutex);
+				auto & entry = newCache[key];
+				entry.lastWrite = lastWrite;
+				entry.header = *result[i];
+			}
+			catch(const std::exception & e)
+			{
+				logGlobal->error("Map %s is invalid. Message: %s", name.getName(), e.what());
+				result[i].reset();
+			}
+		});
+	}
+
+	CThreadHelper loader(&tasks, std::max<int>(1, boost::thread::hardware_concurrency()));
+	loader.run();
+
+	logGlobal->debug("Loaded %d map headers, %d of them from cache", names.size(), cacheHits.load());
+
+	saveMapHeadersCache(modsChecksum, newCache);
+	return result;
+}
+
 void CMapService::saveMap(const std::unique_ptr<CMap> & map, boost::filesystem::path fullPath) const
 {
 	CMemoryBuffer serializeBuffer;
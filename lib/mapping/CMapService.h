@@ -88,6 +88,15 @@ public:
 	std::unique_ptr<CMap> loadMap(const uint8_t * buffer, int size, const std::string & name, const std::string & modName, const std::string & encoding, IGameCallback * cb) const override;
 	std::unique_ptr<CMapHeader> loadMapHeader(const uint8_t * buffer, int size, const std::string & name, const std::string & modName, const std::string & encoding) const override;
 	void saveMap(const std::unique_ptr<CMap> & map, boost::filesystem::path fullPath) const override;
+
+	/**
+	 * Loads headers of multiple maps in parallel. Headers of maps that were not modified since
+	 * previous call are taken from map headers cache in user cache directory instead of map files.
+	 *
+	 * @param names the names of the maps
+	 * @return loaded headers in the same order as names, nullptr for maps that failed to load
+	 */
+	std::vector<std::unique_ptr<CMapHeader>> loadMapHeaders(const std::vector<ResourcePath> & names) const;
 	
 	/**
 	 * Tests if mods used in the map are currently loaded
@@ -120,6 +120,7 @@ void CMapLoaderH3M::init()
 	readEvents();
 
 	map->calculateGuardingGreaturePositions();
+	map->calculateTileFlags();
 	afterRead();
 	//map->banWaterContent(); //Not sure if force this for custom scenarios
 }
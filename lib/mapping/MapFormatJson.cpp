@@ -823,6 +823,7 @@ void CMapLoaderJson::readMap()
 	readObjects();
 
 	map->calculateGuardingGreaturePositions();
+	map->calculateTileFlags();
 }
 
 void CMapLoaderJson::readHeader(const bool complete)
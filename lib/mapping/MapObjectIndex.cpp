@@ -0,0 +1,157 @@
+/*
+ * MapObjectIndex.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "MapObjectIndex.h"
+
+#include "../mapObjects/CGObjectInstance.h"
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+void MapObjectIndex::resize(const int3 & mapSize)
+{
+	cellsCount = int3((mapSize.x + CELL_SIZE - 1) / CELL_SIZE, (mapSize.y + CELL_SIZE - 1) / CELL_SIZE, mapSize.z);
+	cells.clear();
+	cells.resize(static_cast<size_t>(cellsCount.x) * cellsCount.y * cellsCount.z);
+	objectCells.clear();
+}
+
+size_t MapObjectIndex::cellIndex(const int3 & position) const
+{
+	int x = std::clamp(position.x / CELL_SIZE, 0, cellsCount.x - 1);
+	int y = std::clamp(position.y / CELL_SIZE, 0, cellsCount.y - 1);
+	int z = std::clamp(position.z, 0, cellsCount.z - 1);
+
+	return (static_cast<size_t>(z) * cellsCount.y + y) * cellsCount.x + x;
+}
+
+void MapObjectIndex::add(const CGObjectInstance * object)
+{
+	if(cells.empty())
+		return;
+
+	remove(object);
+
+	int3 position = object->isVisitable() ? object->visitablePos() : object->pos;
+	size_t cell = cellIndex(position);
+
+	cells[cell].push_back({object, position});
+	objectCells[object] = cell;
+}
+
+void MapObjectIndex::remove(const CGObjectInstance * object)
+{
+	auto it = objectCells.find(object);
+	if(it == objectCells.end())
+		return;
+
+	auto & entries = cells[it->second];
+	vstd::erase_if(entries, [object](const Entry & entry)
+	{
+		return entry.object == object;
+	});
+	objectCells.erase(it);
+}
+
+std::vector<const CGObjectInstance *> MapObjectIndex::getObjectsInRange(const int3 & center, int radius, std::optional<MapObjectID> type, int3::EDistanceFormula formula) const
+{
+	std::vector<const CGObjectInstance *> result;
+
+	if(cells.empty() || radius < 0 || center.z < 0 || center.z >= cellsCount.z)
+		return result;
+
+	// larger radius covers whole level anyway and may overflow coordinates
+	radius = std::min(radius, (cellsCount.x + cellsCount.y) * CELL_SIZE);
+
+	int x0 = std::max(center.x - radius, 0) / CELL_SIZE;
+	int x1 = std::min((center.x + radius) / CELL_SIZE, cellsCount.x - 1);
+	int y0 = std::max(center.y - radius, 0) / CELL_SIZE;
+	int y1 = std::min((center.y + radius) / CELL_SIZE, cellsCount.y - 1);
+
+	for(int y = y0; y <= y1; y++)
+	{
+		for(int x = x0; x <= x1; x++)
+		{
+			for(const auto & entry : cells[(static_cast<size_t>(center.z) * cellsCount.y + y) * cellsCount.x + x])
+			{
+				if(type && entry.object->ID != *type)
+					continue;
+
+				if(static_cast<int>(center.dist(entry.position, formula)) <= radius)
+					result.push_back(entry.object);
+			}
+		}
+	}
+	return result;
+}
+
+const CGObjectInstance * MapObjectIndex::getNearestObject(const int3 & position, MapObjectID type, const std::function<bool(const CGObjectInstance *)> & filter) const
+{
+	if(cells.empty())
+		return nullptr;
+
+	const int cx = std::clamp(position.x / CELL_SIZE, 0, cellsCount.x - 1);
+	const int cy = std::clamp(position.y / CELL_SIZE, 0, cellsCount.y - 1);
+	const int maxRing = std::max(cellsCount.x, cellsCount.y);
+
+	const CGObjectInstance * nearest = nullptr;
+	ui32 nearestDistance = 0;
+
+	auto checkCell = [&](int x, int y)
+	{
+		if(x < 0 || y < 0 || x >= cellsCount.x || y >= cellsCount.y)
+			return;
+
+		for(int z = 0; z < cellsCount.z; z++)
+		{
+			for(const auto & entry : cells[(static_cast<size_t>(z) * cellsCount.y + y) * cellsCount.x + x])
+			{
+				if(entry.object->ID != type)
+					continue;
+
+				ui32 distance = position.dist2dSQ(entry.position);
+				if(nearest && distance >= nearestDistance)
+					continue;
+
+				if(filter && !filter(entry.object))
+					continue;
+
+				nearest = entry.object;
+				nearestDistance = distance;
+			}
+		}
+	};
+
+	for(int ring = 0; ring <= maxRing; ring++)
+	{
+		// all tiles of this and further rings are at least this far away from position along one of axes
+		if(ring > 0 && nearest)
+		{
+			ui32 minDistance = (ring - 1) * CELL_SIZE + 1;
+			if(nearestDistance <= minDistance * minDistance)
+				break;
+		}
+
+		for(int x = cx - ring; x <= cx + ring; x++)
+		{
+			checkCell(x, cy - ring);
+			if(ring > 0)
+				checkCell(x, cy + ring);
+		}
+
+		for(int y = cy - ring + 1; y <= cy + ring - 1; y++)
+		{
+			checkCell(cx - ring, y);
+			checkCell(cx + ring, y);
+		}
+	}
+	return nearest;
+}
+
+VCMI_LIB_NAMESPACE_END
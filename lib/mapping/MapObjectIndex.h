@@ -0,0 +1,55 @@
+/*
+ * MapObjectIndex.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include "../constants/EntityIdentifiers.h"
+#include "../int3.h"
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+class CGObjectInstance;
+
+/// Spatial index of objects placed on map, based on uniform grid of square cells on each level
+/// Objects are indexed by their visitable position, or by their position if they are not visitable
+/// Kept up to date by CMap::addBlockVisTiles and CMap::removeBlockVisTiles
+class DLL_LINKAGE MapObjectIndex
+{
+	static constexpr int CELL_SIZE = 8;
+
+	struct Entry
+	{
+		const CGObjectInstance * object;
+		int3 position;
+	};
+
+	int3 cellsCount;
+	std::vector<std::vector<Entry>> cells;
+	/// cell of every indexed object
+	std::unordered_map<const CGObjectInstance *, size_t> objectCells;
+
+	size_t cellIndex(const int3 & position) const;
+
+public:
+	/// removes all objects and prepares index for map of specified size
+	void resize(const int3 & mapSize);
+
+	/// adds object to index, or updates its position if it is already indexed
+	void add(const CGObjectInstance * object);
+	void remove(const CGObjectInstance * object);
+
+	/// returns objects on the same level as center within radius, optionally only of specified type
+	std::vector<const CGObjectInstance *> getObjectsInRange(const int3 & center, int radius, std::optional<MapObjectID> type = std::nullopt, int3::EDistanceFormula formula = int3::DIST_2D) const;
+
+	/// returns object of specified type that is closest to position on any level, using same metric as int3::dist2d
+	/// objects rejected by filter are ignored. Returns nullptr if there are no such objects
+	const CGObjectInstance * getNearestObject(const int3 & position, MapObjectID type, const std::function<bool(const CGObjectInstance *)> & filter = nullptr) const;
+};
+
+VCMI_LIB_NAMESPACE_END
@@ -16,9 +16,11 @@
 #include "IdentifierStorage.h"
 #include "ModIncompatibility.h"
 
+#include "../CConfigHandler.h"
 #include "../CCreatureHandler.h"
 #include "../CGeneralTextHandler.h"
 #include "../CStopWatch.h"
+#include "../CThreadHelper.h"
 #include "../GameSettings.h"
 #include "../Languages.h"
 #include "../MetaString.h"
@@ -460,22 +462,52 @@ void CModHandler::load()
 
 	content->init();
 
-	for(const TModID & modName : activeMods)
+	// checksums of mods are independent from each other, calculate them in parallel
+	std::vector<ui32> checksums(activeMods.size());
+	std::vector<CThreadHelper::Task> checksumTasks;
+
+	for(size_t i = 0; i < activeMods.size(); ++i)
 	{
-		logMod->trace("Generating checksum for %s", modName);
-		allMods[modName].updateChecksum(calculateModChecksum(modName, CResourceHandler::get(modName)));
+		checksumTasks.push_back([this, &checksums, i]()
+		{
+			const TModID & modName = activeMods[i];
+			auto start = std::chrono::steady_clock::now();
+			checksums[i] = calculateModChecksum(modName, CResourceHandler::get(modName));
+			logMod->debug("\t\tGenerating checksum for %s: %d ms", modName, std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+		});
 	}
 
+	CThreadHelper checksumCalculator(&checksumTasks, std::max<int>(1, boost::thread::hardware_concurrency()));
+	checksumCalculator.run();
+
+	for(size_t i = 0; i < activeMods.size(); ++i)
+		allMods[activeMods[i]].updateChecksum(checksums[i]);
+
+	// by default only mods with changed checksum (or that failed validation before) are validated
+	if(settings["general"]["modValidation"].String() == "always")
+	{
+		coreMod->validation = CModInfo::PENDING;
+		for(const TModID & modName : activeMods)
+			allMods[modName].validation = CModInfo::PENDING;
+	}
+
+	logMod->info("\tCalculating mod checksums: %d ms", timer.getDiff());
+
 	// first - load virtual builtin mod that contains all data
 	// TODO? move all data into real mods? RoE, AB, SoD, WoG
-	content->preloadData(*coreMod);
+	std::vector<CModInfo *> modsToLoad = { coreMod.get() };
 	for(const TModID & modName : activeMods)
-		content->preloadData(allMods[modName]);
+		modsToLoad.push_back(&allMods[modName]);
+
+	content->preloadData(modsToLoad);
 	logMod->info("\tParsing mod data: %d ms", timer.getDiff());
 
-	content->load(*coreMod);
-	for(const TModID & modName : activeMods)
-		content->load(allMods[modName]);
+	for(CModInfo * mod : modsToLoad)
+	{
+		auto start = std::chrono::steady_clock::now();
+		content->load(*mod);
+		logMod->debug("\t\tLoading data of %s: %d ms", mod->identifier, std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+	}
 
 #if SCRIPTING_ENABLED
 	VLC->scriptHandler->performRegistration(VLC);//todo: this should be done before any other handlers load
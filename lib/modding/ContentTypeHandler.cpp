@@ -16,11 +16,13 @@
 
 #include "../BattleFieldHandler.h"
 #include "../CArtHandler.h"
+#include "../CConfigHandler.h"
 #include "../CCreatureHandler.h"
 #include "../CGeneralTextHandler.h"
 #include "../CHeroHandler.h"
 #include "../CSkillHandler.h"
 #include "../CStopWatch.h"
+#include "../CThreadHelper.h"
 #include "../CTownHandler.h"
 #include "../GameSettings.h"
 #include "../IHandlerBase.h"
@@ -31,9 +33,12 @@
 #include "../ScriptHandler.h"
 #include "../constants/StringConstants.h"
 #include "../TerrainHandler.h"
+#include "../VCMIDirs.h"
 #include "../json/JsonUtils.h"
 #include "../mapObjectConstructors/CObjectClassesHandler.h"
 #include "../rmg/CRmgTemplateStorage.h"
+#include "../serializer/CLoadFile.h"
+#include "../serializer/CSaveFile.h"
 #include "../spells/CSpellHandler.h"
 
 VCMI_LIB_NAMESPACE_BEGIN
@@ -49,10 +54,8 @@ ContentTypeHandler::ContentTypeHandler(IHandlerBase * handler, const std::string
 	}
 }
 
-bool ContentTypeHandler::preloadModData(const std::string & modName, const std::vector<std::string> & fileList, bool validate)
+void ContentTypeHandler::preloadModData(const std::string & modName, JsonNode data)
 {
-	bool result = false;
-	JsonNode data = JsonUtils::assembleFromFiles(fileList, result);
 	data.setModScope(modName);
 
 	ModInfo & modInfo = modData[modName];
@@ -81,7 +84,6 @@ bool ContentTypeHandler::preloadModData(const std::string & modName, const std::
 			JsonUtils::merge(remoteConf, entry.second);
 		}
 	}
-	return result;
 }
 
 bool ContentTypeHandler::loadMod(const std::string & modName, bool validate)
@@ -210,16 +212,6 @@ void CContentHandler::init()
 	//TODO: any other types of moddables?
 }
 
-bool CContentHandler::preloadModData(const std::string & modName, JsonNode modConfig, bool validate)
-{
-	bool result = true;
-	for(auto & handler : handlers)
-	{
-		result &= handler.second.preloadModData(modName, modConfig[handler.first].convertTo<std::vector<std::string> >(), validate);
-	}
-	return result;
-}
-
 bool CContentHandler::loadMod(const std::string & modName, bool validate)
 {
 	bool result = true;
@@ -248,19 +240,154 @@ void CContentHandler::afterLoadFinalization()
 
 void CContentHandler::preloadData(CModInfo & mod)
 {
-	bool validate = (mod.validation != CModInfo::PASSED);
+	preloadData(std::vector<CModInfo *>{ &mod });
+}
+
+static const std::string CONTENT_CACHE_MAGIC = "VCMICNT";
+
+static boost::filesystem::path getContentCachePath(const CModInfo & mod)
+{
+	return VCMIDirs::get().userCachePath() / "modContent" / (mod.identifier + ".vcmi");
+}
 
-	// print message in format [<8-symbols checksum>] <modname>
-	auto & info = mod.getVerificationInfo();
-	logMod->info("\t\t[%08x]%s", info.checksum, info.name);
+/// Checksum of all mods loaded together. Data of a mod is assembled through VFS where other mods may override its files,
+/// so cached data is only valid for the same set of mods
+static ui32 getLoadedModsChecksum(const std::vector<CModInfo *> & mods)
+{
+	boost::crc_32_type result;
+	for(const CModInfo * mod : mods)
+	{
+		ui32 modChecksum = mod->getVerificationInfo().checksum;
+		result.process_bytes(mod->identifier.data(), mod->identifier.size());
+		result.process_bytes(&modChecksum, sizeof(modChecksum));
+	}
+	return result.checksum();
+}
+
+/// Loads parsed data of a mod saved by previous run, if neither files of the mod nor set of loaded mods changed since then
+static bool loadContentCache(const CModInfo & mod, ui32 modsChecksum, std::map<std::string, JsonNode> & data)
+{
+	const auto path = getContentCachePath(mod);
+
+	if (!boost::filesystem::exists(path))
+		return false;
+
+	try
+	{
+		// throws if cache was written by different version of serializer
+		CLoadFile cache(path);
+		cache.checkMagicBytes(CONTENT_CACHE_MAGIC);
+
+		ui32 checksum = 0;
+		ui32 cachedModsChecksum = 0;
+		cache >> checksum;
+		cache >> cachedModsChecksum;
+
+		if (checksum != mod.getVerificationInfo().checksum || cachedModsChecksum != modsChecksum)
+			return false;
+
+		cache >> data;
+		return true;
+	}
+	catch(const std::exception & e)
+	{
+		logMod->warn("Failed to load content cache of mod %s: %s", mod.identifier, e.what());
+		data.clear();
+		return false;
+	}
+}
+
+static void saveContentCache(const CModInfo & mod, ui32 modsChecksum, const std::map<std::string, JsonNode> & data)
+{
+	const auto path = getContentCachePath(mod);
 
-	if (validate && mod.identifier != ModScope::scopeBuiltin())
+	try
 	{
-		if (!JsonUtils::validate(mod.config, "vcmi:mod", mod.identifier))
+		boost::filesystem::create_directories(path.parent_path());
+
+		CSaveFile cache(path);
+		cache.putMagicBytes(CONTENT_CACHE_MAGIC);
+		cache << mod.getVerificationInfo().checksum;
+		cache << modsChecksum;
+		cache << data;
+	}
+	catch(const std::exception & e)
+	{
+		logMod->warn("Failed to save content cache of mod %s: %s", mod.identifier, e.what());
+		boost::filesystem::remove(path);
+	}
+}
+
+void CContentHandler::preloadData(const std::vector<CModInfo *> & mods)
+{
+	struct ParsedMod
+	{
+		std::map<std::string, JsonNode> data;
+		bool isValid = true;
+		bool fromCache = false;
+		int64_t parsingTime = 0;
+	};
+
+	const bool useCache = settings["general"]["modContentCache"].Bool();
+	const ui32 modsChecksum = getLoadedModsChecksum(mods);
+
+	std::vector<ParsedMod> parsedMods(mods.size());
+	std::vector<CThreadHelper::Task> tasks;
+
+	for(size_t i = 0; i < mods.size(); ++i)
+	{
+		tasks.push_back([this, &parsedMods, &mods, useCache, modsChecksum, i]()
+		{
+			auto start = std::chrono::steady_clock::now();
+			const CModInfo & mod = *mods[i];
+			ParsedMod & parsed = parsedMods[i];
+
+			// only data of mods that passed validation is cached, so there is no need to track validity of cached data
+			if (useCache && mod.validation == CModInfo::PASSED)
+				parsed.fromCache = loadContentCache(mod, modsChecksum, parsed.data);
+
+			if (!parsed.fromCache)
+			{
+				for(const auto & handler : handlers)
+				{
+					bool isValid = false;
+					parsed.data[handler.first] = JsonUtils::assembleFromFiles(mod.config[handler.first].convertTo<std::vector<std::string>>(), isValid);
+					parsed.isValid &= isValid;
+				}
+			}
+			parsed.parsingTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+		});
+	}
+
+	CThreadHelper parser(&tasks, std::max<int>(1, boost::thread::hardware_concurrency()));
+	parser.run();
+
+	for(size_t i = 0; i < mods.size(); ++i)
+	{
+		CModInfo & mod = *mods[i];
+		bool validate = (mod.validation != CModInfo::PASSED);
+
+		// print message in format [<8-symbols checksum>] <modname>
+		auto & info = mod.getVerificationInfo();
+		logMod->info("\t\t[%08x]%s", info.checksum, info.name);
+		logMod->debug("\t\t%s data of %s: %d ms", parsedMods[i].fromCache ? "Loading cached" : "Parsing", mod.identifier, parsedMods[i].parsingTime);
+
+		if (validate && mod.identifier != ModScope::scopeBuiltin())
+		{
+			if (!JsonUtils::validate(mod.config, "vcmi:mod", mod.identifier))
+				mod.validation = CModInfo::FAILED;
+		}
+
+		if (!parsedMods[i].isValid)
 			mod.validation = CModInfo::FAILED;
+
+		// data is saved before it is passed to handlers, but cache is only used on next start if mod also passes validation during load
+		if (useCache && !parsedMods[i].fromCache && mod.validation != CModInfo::FAILED)
+			saveContentCache(mod, modsChecksum, parsedMods[i].data);
+
+		for(auto & handler : handlers)
+			handler.second.preloadModData(mod.identifier, std::move(parsedMods[i].data[handler.first]));
 	}
-	if (!preloadModData(mod.identifier, mod.config, validate))
-		mod.validation = CModInfo::FAILED;
 }
 
 void CContentHandler::load(CModInfo & mod)
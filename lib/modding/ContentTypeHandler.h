@@ -38,8 +38,9 @@ public:
 	ContentTypeHandler(IHandlerBase * handler, const std::string & objectName);
 
 	/// local version of methods in ContentHandler
+	/// distributes already parsed data of a mod between this mod and mods patched by it
+	void preloadModData(const std::string & modName, JsonNode data);
 	/// returns true if loading was successful
-	bool preloadModData(const std::string & modName, const std::vector<std::string> & fileList, bool validate);
 	bool loadMod(const std::string & modName, bool validate);
 	void loadCustom();
 	void afterLoadFinalization();
@@ -48,9 +49,6 @@ public:
 /// class used to load all game data into handlers. Used only during loading
 class DLL_LINKAGE CContentHandler
 {
-	/// preloads all data from fileList as data from modName.
-	bool preloadModData(const std::string & modName, JsonNode modConfig, bool validate);
-
 	/// actually loads data in mod
 	bool loadMod(const std::string & modName, bool validate);
 
@@ -62,6 +60,10 @@ public:
 	/// preloads all data from fileList as data from modName.
 	void preloadData(CModInfo & mod);
 
+	/// preloads data of multiple mods. Files of all mods are parsed in parallel,
+	/// but data is applied in order of mods in list since mods may patch objects from preceding mods
+	void preloadData(const std::vector<CModInfo *> & mods);
+
 	/// actually loads data in mod
 	void load(CModInfo & mod);
 
@@ -946,13 +946,10 @@ void SetMovePoints::applyGs(CGameState * gs) const
 void FoWChange::applyGs(CGameState *gs)
 {
 	TeamState * team = gs->getPlayerTeam(player);
-	auto & fogOfWarMap = team->fogOfWarMap;
-	for(const int3 & t : tiles)
-		(*fogOfWarMap)[t.z][t.x][t.y] = mode != ETileVisibility::HIDDEN;
+	team->fogOfWarMap.setVisible(tiles, mode != ETileVisibility::HIDDEN);
 
 	if (mode == ETileVisibility::HIDDEN) //do not hide too much
 	{
-		std::unordered_set<int3> tilesRevealed;
 		for (auto & elem : gs->map->objects)
 		{
 			const CGObjectInstance *o = elem;
@@ -964,14 +961,16 @@ void FoWChange::applyGs(CGameState *gs)
 				case Obj::MINE:
 				case Obj::TOWN:
 				case Obj::ABANDONED_MINE:
-					if(vstd::contains(team->players, o->tempOwner)) //check owned observators
-						gs->getTilesInRange(tilesRevealed, o->getSightCenter(), o->getSightRadius(), ETileVisibility::HIDDEN, o->tempOwner);
+					if(!vstd::contains(team->players, o->tempOwner)) //check owned observators
+						break;
+					if(o->getSightRadius() == CBuilding::HEIGHT_SKYSHIP) //reveal entire map
+						team->fogOfWarMap.resize(team->fogOfWarMap.size(), true);
+					else
+						team->fogOfWarMap.reveal(o->getSightCenter(), o->getSightRadius());
 					break;
 				}
 			}
 		}
-		for(const int3 & t : tilesRevealed) //probably not the most optimal solution ever
-			(*fogOfWarMap)[t.z][t.x][t.y] = 1;
 	}
 }
 
@@ -1328,9 +1327,7 @@ void TryMoveHero::applyGs(CGameState *gs)
 		gs->map->addBlockVisTiles(h);
 	}
 
-	auto & fogOfWarMap = gs->getPlayerTeam(h->getOwner())->fogOfWarMap;
-	for(const int3 & t : fowRevealed)
-		(*fogOfWarMap)[t.z][t.x][t.y] = 1;
+	gs->getPlayerTeam(h->getOwner())->fogOfWarMap.setVisible(fowRevealed, true);
 }
 
 void NewStructures::applyGs(CGameState *gs)
@@ -22,6 +22,7 @@
 #include "../ResourceSet.h"
 #include "../TurnTimerInfo.h"
 #include "../gameState/EVictoryLossCheckResult.h"
+#include "../gameState/FogOfWarMap.h"
 #include "../gameState/QuestInfo.h"
 #include "../gameState/TavernSlot.h"
 #include "../int3.h"
@@ -333,7 +334,7 @@ struct DLL_LINKAGE FoWChange : public CPackForClient
 
 	template <typename Handler> void serialize(Handler & h)
 	{
-		h & tiles;
+		FogOfWarMap::serializeTiles(h, tiles);
 		h & player;
 		h & mode;
 		h & waitForDialogs;
@@ -651,7 +652,7 @@ struct DLL_LINKAGE TryMoveHero : public CPackForClient
 		h & start;
 		h & end;
 		h & movePoints;
-		h & fowRevealed;
+		FogOfWarMap::serializeTiles(h, fowRevealed);
 		h & attackedFrom;
 	}
 };
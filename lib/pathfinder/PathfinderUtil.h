@@ -11,29 +11,34 @@
 
 #include "../TerrainHandler.h"
 #include "../mapObjects/CGObjectInstance.h"
-#include "../mapping/CMapDefines.h"
+#include "../mapping/CMap.h"
 #include "../gameState/CGameState.h"
+#include "../gameState/FogOfWarMap.h"
 #include "CGPathNode.h"
 
 VCMI_LIB_NAMESPACE_BEGIN
 
 namespace PathfinderUtil
 {
-	using FoW = std::unique_ptr<boost::multi_array<ui8, 3>>;
+	using FoW = FogOfWarMap;
 	using ELayer = EPathfindingLayer;
 
+	/// Evaluates accessibility of tile using its packed properties, see CMap::getTileFlags
+	/// Full tile information is only read for tiles with visitable objects
 	template<EPathfindingLayer::Type layer>
-	EPathAccessibility evaluateAccessibility(const int3 & pos, const TerrainTile & tinfo, const FoW & fow, const PlayerColor player, const CGameState * gs)
+	EPathAccessibility evaluateAccessibility(const int3 & pos, ui8 tileFlags, const FoW & fow, const PlayerColor player, const CGameState * gs)
 	{
-		if(!(*fow)[pos.z][pos.x][pos.y])
+		if(!fow.isVisible(pos))
 			return EPathAccessibility::BLOCKED;
 
 		switch(layer)
 		{
 		case ELayer::LAND:
 		case ELayer::SAIL:
-			if(tinfo.visitable)
+			if(tileFlags & ETileFlag::VISITABLE)
 			{
+				const TerrainTile & tinfo = gs->map->getTile(pos);
+
 				if(tinfo.visitableObjects.front()->ID == Obj::SANCTUARY && tinfo.visitableObjects.back()->ID == Obj::HERO && tinfo.visitableObjects.back()->tempOwner != player) //non-owned hero stands on Sanctuary
 				{
 					return EPathAccessibility::BLOCKED;
@@ -51,7 +56,7 @@ namespace PathfinderUtil
 					}
 				}
 			}
-			else if(tinfo.blocked)
+			else if(tileFlags & ETileFlag::BLOCKED)
 			{
 				return EPathAccessibility::BLOCKED;
 			}
@@ -64,7 +69,7 @@ namespace PathfinderUtil
 			break;
 
 		case ELayer::WATER:
-			if(tinfo.blocked || tinfo.terType->isLand())
+			if(tileFlags & (ETileFlag::BLOCKED | ETileFlag::LAND))
 				return EPathAccessibility::BLOCKED;
 
 			break;
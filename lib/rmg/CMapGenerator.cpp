@@ -124,6 +124,7 @@ std::unique_ptr<CMap> CMapGenerator::generate()
 		map->addModificators();
 		Load::Progress::step(3);
 		fillZones();
+		map->getMap(this).calculateTileFlags();
 		//updated guarded tiles will be calculated in CGameState::initMapObjects()
 		map->getZones().clear();
 	}
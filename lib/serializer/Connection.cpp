@@ -68,7 +68,7 @@ CConnection::CConnection(std::weak_ptr<INetworkConnection> networkConnection)
 
 CConnection::~CConnection() = default;
 
-void CConnection::sendPack(const CPack * pack)
+size_t CConnection::sendPack(const CPack * pack)
 {
 	boost::mutex::scoped_lock lock(writeMutex);
 
@@ -82,7 +82,9 @@ void CConnection::sendPack(const CPack * pack)
 	logNetwork->trace("Sending a pack of type %s", typeid(*pack).name());
 
 	connectionPtr->sendPacket(packWriter->buffer);
+	size_t packSize = packWriter->buffer.size();
 	packWriter->buffer.clear();
+	return packSize;
 }
 
 CPack * CConnection::retrievePack(const std::vector<std::byte> & data)
@@ -51,7 +51,8 @@ public:
 	explicit CConnection(std::weak_ptr<INetworkConnection> networkConnection);
 	~CConnection();
 
-	void sendPack(const CPack * pack);
+	/// Returns size of serialized pack in bytes
+	size_t sendPack(const CPack * pack);
 	CPack * retrievePack(const std::vector<std::byte> & data);
 
 	void enterLobbyConnectionMode();
@@ -38,6 +38,7 @@ enum class ESerializationVersion : int32_t
 	CAMPAIGN_MAP_TRANSLATIONS, // 835 +campaigns include translations for its maps
 	JSON_FLAGS, // 836 json uses new format for flags
 	MANA_LIMIT,	// 837 change MANA_PER_KNOWLEGDE to percentage
+	PACKED_FOG_OF_WAR, // 838 fog of war is stored as bitset, sets of tiles in packs are sent as runs
 
-	CURRENT = MANA_LIMIT
+	CURRENT = PACKED_FOG_OF_WAR
 };
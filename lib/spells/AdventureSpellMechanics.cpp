@@ -180,24 +180,11 @@ ESpellCastResult SummonBoatMechanics::applyAdventureEffects(SpellCastEnvironment
 	}
 
 	//try to find unoccupied boat to summon
-	const CGBoat * nearest = nullptr;
-	double dist = 0;
-	for(const CGObjectInstance * obj : env->getMap()->objects)
+	const auto * nearest = env->getMap()->getObjectIndex().getNearestObject(parameters.caster->getHeroCaster()->visitablePos(), Obj::BOAT, [](const CGObjectInstance * obj)
 	{
-		if(obj && obj->ID == Obj::BOAT)
-		{
-			const auto * b = dynamic_cast<const CGBoat *>(obj);
-			if(b->hero || b->layer != EPathfindingLayer::SAIL)
-				continue; //we're looking for unoccupied boat
-
-			double nDist = b->pos.dist2d(parameters.caster->getHeroCaster()->visitablePos());
-			if(!nearest || nDist < dist) //it's first boat or closer than previous
-			{
-				nearest = b;
-				dist = nDist;
-			}
-		}
-	}
+		const auto * b = dynamic_cast<const CGBoat *>(obj);
+		return b && !b->hero && b->layer == EPathfindingLayer::SAIL; //we're looking for unoccupied boat
+	});
 
 	if(nullptr != nearest) //we found boat to summon
 	{
@@ -611,7 +598,7 @@ ESpellCastResult ViewMechanics::applyAdventureEffects(SpellCastEnvironment * env
 		{
 			ObjectPosInfo posInfo(obj);
 
-			if((*fowMap)[posInfo.pos.z][posInfo.pos.x][posInfo.pos.y] == 0)
+			if(!fowMap.isVisible(posInfo.pos))
 				pack.objectPositions.push_back(posInfo);
 		}
 	}
@@ -13,6 +13,7 @@
 #include "CVCMIServer.h"
 #include "ServerNetPackVisitors.h"
 #include "ServerSpellCastEnvironment.h"
+#include "TurnProfiler.h"
 #include "battles/BattleProcessor.h"
 #include "processors/HeroPoolProcessor.h"
 #include "processors/PlayerMessageProcessor.h"
@@ -479,6 +480,8 @@ void CGameHandler::handleReceivedPack(CPackForServer * pack)
 		pack->c->sendPack(&applied);
 	};
 
+	TurnProfiler::Scope profilerScope(profiler.get(), "pack", typeid(*pack), pack->player);
+
 	CBaseForGHApply * apply = applier->getApplier(CTypeList::getInstance().getTypeID(pack)); //and appropriate applier object
 	if(isBlockedByQueries(pack, pack->player))
 	{
@@ -506,10 +509,11 @@ void CGameHandler::handleReceivedPack(CPackForServer * pack)
 
 CGameHandler::CGameHandler(CVCMIServer * lobby)
 	: lobby(lobby)
+	, profiler(TurnProfiler::createIfEnabled())
 	, heroPool(std::make_unique<HeroPoolProcessor>(this))
 	, battles(std::make_unique<BattleProcessor>(this))
 	, turnOrder(std::make_unique<TurnOrderProcessor>(this))
-	, queries(std::make_unique<QueriesProcessor>())
+	, queries(std::make_unique<QueriesProcessor>(profiler.get()))
 	, playerMessages(std::make_unique<PlayerMessageProcessor>(this))
 	, complainNoCreatures("No creatures to split")
 	, complainNotEnoughCreatures("Cannot split that stack, not enough creatures!")
@@ -653,6 +657,7 @@ void CGameHandler::onPlayerTurnEnded(PlayerColor which)
 
 void CGameHandler::onNewTurn()
 {
+	TurnProfiler::Scope profilerScope(profiler.get(), "turn", "new day");
 	logGlobal->trace("Turn %d", gs->day+1);
 	NewTurn n;
 	n.specialWeek = NewTurn::NO_ACTION;
@@ -665,6 +670,14 @@ void CGameHandler::onNewTurn()
 
 	std::map<PlayerColor, si32> hadGold;//starting gold - for buildings like dwarven treasury
 
+	auto phaseStart = std::chrono::steady_clock::now();
+	auto logPhase = [&phaseStart](const std::string & phase)
+	{
+		auto now = std::chrono::steady_clock::now();
+		logGlobal->debug("New turn: %s took %d ms", phase, std::chrono::duration_cast<std::chrono::milliseconds>(now - phaseStart).count());
+		phaseStart = now;
+	};
+
 	if (firstTurn)
 	{
 		for (auto obj : gs->map->objects)
@@ -736,6 +749,12 @@ void CGameHandler::onNewTurn()
 		}
 	}
 
+	logPhase("special week");
+
+	// Phase 1: changes of game state that may affect values evaluated below
+	std::vector<PlayerColor> players;
+	std::vector<CGHeroInstance *> heroes;
+
 	for (auto & elem : gs->players)
 	{
 		if (elem.first == PlayerColor::NEUTRAL)
@@ -750,117 +769,185 @@ void CGameHandler::onNewTurn()
 			heroPool->onNewWeek(elem.first);
 
 		n.res[elem.first] = elem.second.resources;
+		players.push_back(elem.first);
 
-		if(!firstTurn && newWeek) //weekly crystal generation if 1 or more crystal dragons in any hero army or town garrison
+		for (CGHeroInstance *h : (elem).second.heroes)
 		{
-			bool hasCrystalGenCreature = false;
-			for(CGHeroInstance * hero : elem.second.heroes)
-			{
-				for(auto stack : hero->stacks)
-				{
-					if(stack.second->hasBonusOfType(BonusType::SPECIAL_CRYSTAL_GENERATION))
-					{
-						hasCrystalGenCreature = true;
-						break;
-					}
-				}
-			}
-			if(!hasCrystalGenCreature) //not found in armies, check towns
+			if (h->visitedTown)
+				giveSpells(h->visitedTown, h);
+
+			heroes.push_back(h);
+		}
+	}
+
+	std::vector<CGTownInstance *> towns(gs->map->towns.begin(), gs->map->towns.end());
+
+	for (CGTownInstance *t : towns)
+	{
+		handleTownEvents(t, n);
+
+		if (newWeek && t->hasBuilt(BuildingSubID::PORTAL_OF_SUMMONING))
+			setPortalDwelling(t, true, (n.specialWeek == NewTurn::PLAGUE ? true : false)); //set creatures for Portal of Summoning
+	}
+	logPhase("state updates");
+
+	// Phase 2: evaluation of new values, independent for each player, hero and town. Game state is not modified here
+	std::vector<ui8> playersCrystalGeneration(players.size(), false);
+	std::vector<NewTurn::Hero> heroesInfo(heroes.size());
+	std::vector<TResources> heroesIncome(heroes.size());
+	std::vector<TResources> townsIncome(towns.size());
+	std::vector<SetAvailableCreatures> townsCreatures(towns.size());
+
+	std::vector<CThreadHelper::Task> tasks;
+
+	if(!firstTurn && newWeek) //weekly crystal generation if 1 or more crystal dragons in any hero army or town garrison
+	{
+		for (size_t i = 0; i < players.size(); i++)
+		{
+			tasks.push_back([this, i, &players, &playersCrystalGeneration]()
 			{
-				for(CGTownInstance * town : elem.second.towns)
+				auto hasCrystalGenCreature = [](const CCreatureSet * army)
 				{
-					for(auto stack : town->stacks)
+					for(const auto & stack : army->stacks)
 					{
 						if(stack.second->hasBonusOfType(BonusType::SPECIAL_CRYSTAL_GENERATION))
-						{
-							hasCrystalGenCreature = true;
-							break;
-						}
+							return true;
 					}
-				}
-			}
-			if(hasCrystalGenCreature)
-				n.res[elem.first][EGameResID::CRYSTAL] += 3;
+					return false;
+				};
+
+				const PlayerState * state = getPlayerState(players[i]);
+				playersCrystalGeneration[i] = std::any_of(state->heroes.begin(), state->heroes.end(), hasCrystalGenCreature)
+					|| std::any_of(state->towns.begin(), state->towns.end(), hasCrystalGenCreature);
+			});
 		}
+	}
 
-		for (CGHeroInstance *h : (elem).second.heroes)
+	for (size_t i = 0; i < heroes.size(); i++)
+	{
+		tasks.push_back([this, i, firstTurn, &heroes, &heroesInfo, &heroesIncome]()
 		{
-			if (h->visitedTown)
-				giveSpells(h->visitedTown, h);
+			const CGHeroInstance * h = heroes[i];
 
-			NewTurn::Hero hth;
+			NewTurn::Hero & hth = heroesInfo[i];
 			hth.id = h->id;
 			auto ti = std::make_unique<TurnInfo>(h, 1);
 			// TODO: this code executed when bonuses of previous day not yet updated (this happen in NewTurn::applyGs). See issue 2356
 			hth.move = h->movementPointsLimitCached(gs->map->getTile(h->visitablePos()).terType->isLand(), ti.get());
 			hth.mana = h->getManaNewTurn();
 
-			n.heroes.insert(hth);
-
 			if (!firstTurn) //not first day
 			{
 				for (GameResID k = GameResID::WOOD; k < GameResID::COUNT; k++)
 				{
-					n.res[elem.first][k] += h->valOfBonuses(BonusType::GENERATE_RESOURCE, BonusSubtypeID(k));
+					heroesIncome[i][k] += h->valOfBonuses(BonusType::GENERATE_RESOURCE, BonusSubtypeID(k));
 				}
 			}
-		}
+		});
 	}
-	for (CGTownInstance *t : gs->map->towns)
+
+	for (size_t i = 0; i < towns.size(); i++)
 	{
-		PlayerColor player = t->tempOwner;
-		handleTownEvents(t, n);
 		if (newWeek) //first day of week
 		{
-			if (t->hasBuilt(BuildingSubID::PORTAL_OF_SUMMONING))
-				setPortalDwelling(t, true, (n.specialWeek == NewTurn::PLAGUE ? true : false)); //set creatures for Portal of Summoning
+			const CGTownInstance * t = towns[i];
 
-			if (!firstTurn)
-				if (t->hasBuilt(BuildingSubID::TREASURY) && player.isValidPlayer())
-						n.res[player][EGameResID::GOLD] += hadGold.at(player)/10; //give 10% of starting gold
-
-			if (!vstd::contains(n.cres, t->id))
+			if (vstd::contains(n.cres, t->id))
+				townsCreatures[i] = n.cres.at(t->id);
+			else
 			{
-				n.cres[t->id].tid = t->id;
-				n.cres[t->id].creatures = t->creatures;
+				townsCreatures[i].tid = t->id;
+				townsCreatures[i].creatures = t->creatures;
 			}
-			auto & sac = n.cres.at(t->id);
+		}
 
-			for (int k=0; k < GameConstants::CREATURES_PER_TOWN; k++) //creature growths
+		tasks.push_back([i, firstTurn, newWeek, &n, &towns, &townsIncome, &townsCreatures]()
+		{
+			const CGTownInstance * t = towns[i];
+
+			if (newWeek) //first day of week
 			{
-				if (!t->creatures.at(k).second.empty()) // there are creatures at this level
-				{
-					ui32 &availableCount = sac.creatures.at(k).first;
-					const CCreature *cre = t->creatures.at(k).second.back().toCreature();
+				auto & sac = townsCreatures[i];
 
-					if (n.specialWeek == NewTurn::PLAGUE)
-						availableCount = t->creatures.at(k).first / 2; //halve their number, no growth
-					else
+				for (int k=0; k < GameConstants::CREATURES_PER_TOWN; k++) //creature growths
+				{
+					if (!t->creatures.at(k).second.empty()) // there are creatures at this level
 					{
-						if (firstTurn) //first day of game: use only basic growths
-							availableCount = cre->getGrowth();
-						else
-							availableCount += t->creatureGrowth(k);
+						ui32 &availableCount = sac.creatures.at(k).first;
+						const CCreature *cre = t->creatures.at(k).second.back().toCreature();
 
-						//Deity of fire week - upgrade both imps and upgrades
-						if (n.specialWeek == NewTurn::DEITYOFFIRE && vstd::contains(t->creatures.at(k).second, n.creatureid))
-							availableCount += 15;
-
-						if (cre->getId() == n.creatureid) //bonus week, effect applies only to identical creatures
+						if (n.specialWeek == NewTurn::PLAGUE)
+							availableCount = t->creatures.at(k).first / 2; //halve their number, no growth
+						else
 						{
-							if (n.specialWeek == NewTurn::DOUBLE_GROWTH)
-								availableCount *= 2;
-							else if (n.specialWeek == NewTurn::BONUS_GROWTH)
-								availableCount += 5;
+							if (firstTurn) //first day of game: use only basic growths
+								availableCount = cre->getGrowth();
+							else
+								availableCount += t->creatureGrowth(k);
+
+							//Deity of fire week - upgrade both imps and upgrades
+							if (n.specialWeek == NewTurn::DEITYOFFIRE && vstd::contains(t->creatures.at(k).second, n.creatureid))
+								availableCount += 15;
+
+							if (cre->getId() == n.creatureid) //bonus week, effect applies only to identical creatures
+							{
+								if (n.specialWeek == NewTurn::DOUBLE_GROWTH)
+									availableCount *= 2;
+								else if (n.specialWeek == NewTurn::BONUS_GROWTH)
+									availableCount += 5;
+							}
 						}
 					}
 				}
 			}
+
+			if (!firstTurn  &&  t->tempOwner.isValidPlayer())//not the first day and town not neutral
+				townsIncome[i] = t->dailyIncome();
+		});
+	}
+
+	CThreadHelper helper(&tasks, std::max<int>(1, boost::thread::hardware_concurrency()));
+	helper.run();
+	logPhase("evaluation");
+
+	// Phase 3: merge evaluated values into pack, in fixed order
+	for (size_t i = 0; i < players.size(); i++)
+	{
+		if (playersCrystalGeneration[i])
+			n.res[players[i]][EGameResID::CRYSTAL] += 3;
+	}
+
+	for (size_t i = 0; i < heroes.size(); i++)
+	{
+		n.heroes.insert(heroesInfo[i]);
+
+		if (!firstTurn) //not first day
+			n.res[heroes[i]->tempOwner] += heroesIncome[i];
+	}
+
+	for (size_t i = 0; i < towns.size(); i++)
+	{
+		const CGTownInstance * t = towns[i];
+		PlayerColor player = t->tempOwner;
+
+		if (newWeek) //first day of week
+		{
+			if (!firstTurn)
+				if (t->hasBuilt(BuildingSubID::TREASURY) && player.isValidPlayer())
+						n.res[player][EGameResID::GOLD] += hadGold.at(player)/10; //give 10% of starting gold
+
+			n.cres[t->id] = townsCreatures[i];
 		}
 		if (!firstTurn  &&  player.isValidPlayer())//not the first day and town not neutral
 		{
-			n.res[player] = n.res[player] + t->dailyIncome();
+			n.res[player] = n.res[player] + townsIncome[i];
 		}
+	}
+	logPhase("merge");
+
+	for (CGTownInstance *t : towns)
+	{
+		PlayerColor player = t->tempOwner;
 		if(t->hasBuilt(BuildingID::GRAIL)
 			&& t->town->buildings.at(BuildingID::GRAIL)->height == CBuilding::HEIGHT_SKYSHIP)
 		{
@@ -872,14 +959,7 @@ void CGameHandler::onNewTurn()
 				fw.mode = ETileVisibility::REVEALED;
 				fw.player = player;
 				// find all hidden tiles
-				const auto & fow = getPlayerTeam(player)->fogOfWarMap;
-
-				auto shape = fow->shape();
-				for(size_t z = 0; z < shape[0]; z++)
-					for(size_t x = 0; x < shape[1]; x++)
-						for(size_t y = 0; y < shape[2]; y++)
-							if (!(*fow)[z][x][y])
-								fw.tiles.insert(int3(x, y, z));
+				getPlayerTeam(player)->fogOfWarMap.getTiles(fw.tiles, false);
 
 				sendAndApply (&fw);
 			}
@@ -894,6 +974,7 @@ void CGameHandler::onNewTurn()
 			}
 		}
 	}
+	logPhase("town effects");
 
 	if (newMonth)
 	{
@@ -965,11 +1046,16 @@ void CGameHandler::onNewTurn()
 	logGlobal->trace("Info about turn %d has been sent!", n.day);
 	handleTimeEvents();
 	//call objects
-	for (auto & elem : gs->map->objects)
 	{
-		if (elem)
-			elem->newTurn(getRandomGenerator());
+		// objects send many small packs, e.g. growth of every wandering monster
+		CBonusSystemNode::ChangesBatch changesBatch;
+		for (auto & elem : gs->map->objects)
+		{
+			if (elem)
+				elem->newTurn(getRandomGenerator());
+		}
 	}
+	logPhase("map objects");
 
 	synchronizeArtifactHandlerLists(); //new day events may have changed them. TODO better of managing that
 }
@@ -1672,8 +1758,17 @@ void CGameHandler::heroExchange(ObjectInstanceID hero1, ObjectInstanceID hero2)
 void CGameHandler::sendToAllClients(CPackForClient * pack)
 {
 	logNetwork->trace("\tSending to all clients: %s", typeid(*pack).name());
+
+	// game handler without lobby is used by headless battle simulator, there are no clients to send packs to
+	if (!lobby)
+		return;
+
+	size_t packSize = 0;
 	for (auto c : lobby->activeConnections)
-		c->sendPack(pack);
+		packSize = c->sendPack(pack);
+
+	if (profiler)
+		profiler->onPackSent(packSize);
 }
 
 void CGameHandler::sendAndApply(CPackForClient * pack)
@@ -4171,18 +4266,23 @@ void CGameHandler::changeFogOfWar(int3 center, ui32 radius, PlayerColor player,
 	{
 		getTilesInRange(tiles, center, radius, ETileVisibility::REVEALED, player);
 
-		std::unordered_set<int3> observedTiles; //do not hide tiles observed by heroes. May lead to disastrous AI problems
+		FogOfWarMap observedTiles(getMapSize()); //do not hide tiles observed by heroes. May lead to disastrous AI problems
 		auto p = getPlayerState(player);
 		for (auto h : p->heroes)
 		{
-			getTilesInRange(observedTiles, h->getSightCenter(), h->getSightRadius(), ETileVisibility::REVEALED, h->tempOwner);
+			observedTiles.reveal(h->getSightCenter(), h->getSightRadius());
 		}
 		for (auto t : p->towns)
 		{
-			getTilesInRange(observedTiles, t->getSightCenter(), t->getSightRadius(), ETileVisibility::REVEALED, t->tempOwner);
+			if (t->getSightRadius() == CBuilding::HEIGHT_SKYSHIP) //town observes entire map
+				observedTiles.resize(getMapSize(), true);
+			else
+				observedTiles.reveal(t->getSightCenter(), t->getSightRadius());
 		}
-		for (auto tile : observedTiles)
-			vstd::erase_if_present (tiles, tile);
+		vstd::erase_if(tiles, [&observedTiles](const int3 & tile)
+		{
+			return observedTiles.isVisible(tile);
+		});
 	}
 	else
 	{
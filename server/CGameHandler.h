@@ -51,6 +51,7 @@ class BattleProcessor;
 class TurnOrderProcessor;
 class QueriesProcessor;
 class CObjectVisitQuery;
+class TurnProfiler;
 
 class CGameHandler : public IGameCallback, public Environment
 {
@@ -58,6 +59,8 @@ class CGameHandler : public IGameCallback, public Environment
 	std::shared_ptr<CApplier<CBaseForGHApply>> applier;
 
 public:
+	/// null unless profiling is enabled in settings
+	std::unique_ptr<TurnProfiler> profiler;
 	std::unique_ptr<HeroPoolProcessor> heroPool;
 	std::unique_ptr<BattleProcessor> battles;
 	std::unique_ptr<QueriesProcessor> queries;
@@ -0,0 +1,214 @@
+/*
+ * TurnProfiler.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "TurnProfiler.h"
+
+#include "../lib/CConfigHandler.h"
+#include "../lib/VCMIDirs.h"
+#include "../lib/json/JsonNode.h"
+
+#include <boost/core/demangle.hpp>
+
+/// turn events of different players may overlap, so each player gets own track after tracks of threads
+static constexpr int PLAYER_TRACKS_START = 100;
+
+TurnProfiler::Scope::Scope(TurnProfiler * profiler, const char * category, const std::type_info & type, PlayerColor player)
+	: Scope(profiler, category, profiler ? boost::core::demangle(type.name()) : std::string(), player)
+{
+}
+
+TurnProfiler::Scope::Scope(TurnProfiler * profiler, const char * category, const std::string & name, PlayerColor player)
+	: profiler(profiler)
+	, category(category)
+	, name(name)
+	, player(player)
+	, start(Clock::now())
+	, startPacks(profiler ? profiler->sentPacks.load() : 0)
+	, startBytes(profiler ? profiler->sentBytes.load() : 0)
+{
+}
+
+TurnProfiler::Scope::~Scope()
+{
+	if(!profiler)
+		return;
+
+	Event event;
+	event.name = std::move(name);
+	event.category = category;
+	event.player = player;
+	event.start = profiler->toMicroseconds(start);
+	event.duration = profiler->toMicroseconds(Clock::now()) - event.start;
+	event.sentPacks = profiler->sentPacks - startPacks;
+	event.sentBytes = profiler->sentBytes - startBytes;
+	profiler->addEvent(std::move(event), true);
+}
+
+std::unique_ptr<TurnProfiler> TurnProfiler::createIfEnabled()
+{
+	if(!settings["server"]["profiler"].Bool())
+		return nullptr;
+
+	auto path = VCMIDirs::get().userLogsPath() / "VCMI_Server_profile.json";
+	logGlobal->info("Server profiler is enabled, results will be written to %s", path.string());
+	return std::make_unique<TurnProfiler>(path);
+}
+
+TurnProfiler::TurnProfiler(const boost::filesystem::path & outputPath)
+	: outputPath(outputPath)
+	, creationTime(Clock::now())
+{
+}
+
+TurnProfiler::~TurnProfiler()
+{
+	try
+	{
+		save();
+	}
+	catch(const std::exception & e)
+	{
+		logGlobal->error("Failed to write server profile: %s", e.what());
+	}
+}
+
+int64_t TurnProfiler::toMicroseconds(Clock::time_point time) const
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(time - creationTime).count();
+}
+
+void TurnProfiler::addEvent(Event && event, bool currentThread)
+{
+	boost::mutex::scoped_lock lock(eventsMutex);
+
+	if(currentThread)
+	{
+		auto it = threadTracks.try_emplace(boost::this_thread::get_id(), static_cast<int>(threadTracks.size())).first;
+		event.track = it->second;
+	}
+	events.push_back(std::move(event));
+}
+
+void TurnProfiler::onPackSent(size_t bytes)
+{
+	sentPacks++;
+	sentBytes += bytes;
+}
+
+void TurnProfiler::onTurnStarted(PlayerColor player)
+{
+	boost::mutex::scoped_lock lock(eventsMutex);
+	turnStarts[player] = Clock::now();
+}
+
+void TurnProfiler::onTurnEnded(PlayerColor player, const std::string & name)
+{
+	Clock::time_point start;
+	{
+		boost::mutex::scoped_lock lock(eventsMutex);
+		auto it = turnStarts.find(player);
+		if(it == turnStarts.end())
+			return; // turn started before game was loaded
+		start = it->second;
+		turnStarts.erase(it);
+	}
+
+	Event event;
+	event.name = name;
+	event.category = "turn";
+	event.player = player;
+	event.start = toMicroseconds(start);
+	event.duration = toMicroseconds(Clock::now()) - event.start;
+	event.track = PLAYER_TRACKS_START + player.getNum();
+	event.sentPacks = 0;
+	event.sentBytes = 0;
+	addEvent(std::move(event), false);
+}
+
+void TurnProfiler::save() const
+{
+	struct Totals
+	{
+		size_t count = 0;
+		int64_t duration = 0;
+		int64_t maxDuration = 0;
+		size_t sentPacks = 0;
+		size_t sentBytes = 0;
+	};
+
+	JsonNode trace;
+	JsonNode & traceEvents = trace["traceEvents"];
+	std::map<std::pair<std::string, std::string>, Totals> totals;
+
+	for(const auto & event : events)
+	{
+		JsonNode entry;
+		entry["name"].String() = event.name;
+		entry["cat"].String() = event.category;
+		entry["ph"].String() = "X";
+		entry["ts"].Integer() = event.start;
+		entry["dur"].Integer() = event.duration;
+		entry["pid"].Integer() = 1;
+		entry["tid"].Integer() = event.track;
+		if(event.player.isValidPlayer())
+			entry["args"]["player"].String() = event.player.toString();
+		if(event.sentPacks != 0)
+		{
+			entry["args"]["sentPacks"].Integer() = event.sentPacks;
+			entry["args"]["sentBytes"].Integer() = event.sentBytes;
+		}
+		traceEvents.Vector().push_back(entry);
+
+		auto & total = totals[{event.category, event.name}];
+		total.count++;
+		total.duration += event.duration;
+		total.maxDuration = std::max(total.maxDuration, event.duration);
+		total.sentPacks += event.sentPacks;
+		total.sentBytes += event.sentBytes;
+	}
+
+	auto addTrackName = [&traceEvents](int track, const std::string & name)
+	{
+		JsonNode entry;
+		entry["name"].String() = "thread_name";
+		entry["ph"].String() = "M";
+		entry["pid"].Integer() = 1;
+		entry["tid"].Integer() = track;
+		entry["args"]["name"].String() = name;
+		traceEvents.Vector().push_back(entry);
+	};
+
+	for(const auto & thread : threadTracks)
+		addTrackName(thread.second, "thread " + std::to_string(thread.second));
+
+	std::set<PlayerColor> playersWithTurns;
+	for(const auto & event : events)
+		if(event.track >= PLAYER_TRACKS_START)
+			playersWithTurns.insert(event.player);
+
+	for(const auto & player : playersWithTurns)
+		addTrackName(PLAYER_TRACKS_START + player.getNum(), "turns of " + player.toString());
+
+	// totals are also stored in trace, so slowest types can be found without viewer
+	for(const auto & [key, total] : totals)
+	{
+		JsonNode & entry = trace["otherData"][key.first][key.second];
+		entry["count"].Integer() = total.count;
+		entry["totalMs"].Float() = total.duration / 1000.0;
+		entry["maxMs"].Float() = total.maxDuration / 1000.0;
+		entry["sentPacks"].Integer() = total.sentPacks;
+		entry["sentBytes"].Integer() = total.sentBytes;
+	}
+
+	std::ofstream file(outputPath.c_str(), std::ofstream::out | std::ofstream::trunc);
+	file << trace.toCompactString();
+
+	logGlobal->info("Server profile with %d events written to %s", events.size(), outputPath.string());
+}
@@ -0,0 +1,76 @@
+/*
+ * TurnProfiler.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include "../lib/constants/EntityIdentifiers.h"
+
+/// Optional instrumentation of game handler, enabled by "server/profiler" setting
+/// Records wall time of processed packs, queries, battle flow and player turns, and size of packs sent to clients meanwhile
+/// Collected events are written when game ends in Chrome trace event format, viewable in chrome://tracing or Perfetto
+class TurnProfiler : boost::noncopyable
+{
+	using Clock = std::chrono::steady_clock;
+
+	struct Event
+	{
+		std::string name;
+		std::string category;
+		PlayerColor player;
+		int64_t start; // microseconds since creation of profiler
+		int64_t duration;
+		int track; // index of thread, or of player for turn events
+		size_t sentPacks;
+		size_t sentBytes;
+	};
+
+	boost::filesystem::path outputPath;
+	Clock::time_point creationTime;
+
+	boost::mutex eventsMutex;
+	std::vector<Event> events;
+	std::map<boost::thread::id, int> threadTracks;
+	std::map<PlayerColor, Clock::time_point> turnStarts;
+
+	std::atomic<size_t> sentPacks = 0;
+	std::atomic<size_t> sentBytes = 0;
+
+	int64_t toMicroseconds(Clock::time_point time) const;
+	void addEvent(Event && event, bool currentThread);
+	void save() const;
+
+public:
+	/// Measures its own lifetime, does nothing if profiler is null
+	class Scope : boost::noncopyable
+	{
+		TurnProfiler * profiler;
+		const char * category;
+		std::string name;
+		PlayerColor player;
+		Clock::time_point start;
+		size_t startPacks;
+		size_t startBytes;
+
+	public:
+		Scope(TurnProfiler * profiler, const char * category, const std::type_info & type, PlayerColor player = PlayerColor::CANNOT_DETERMINE);
+		Scope(TurnProfiler * profiler, const char * category, const std::string & name, PlayerColor player = PlayerColor::CANNOT_DETERMINE);
+		~Scope();
+	};
+
+	/// Returns profiler if it is enabled in settings, nullptr otherwise
+	static std::unique_ptr<TurnProfiler> createIfEnabled();
+
+	explicit TurnProfiler(const boost::filesystem::path & outputPath);
+	/// Writes collected events to output file
+	~TurnProfiler();
+
+	void onPackSent(size_t bytes);
+	void onTurnStarted(PlayerColor player);
+	void onTurnEnded(PlayerColor player, const std::string & name);
+};
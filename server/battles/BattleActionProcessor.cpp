@@ -456,7 +456,7 @@ bool BattleActionProcessor::doUnitSpellAction(const CBattleInfoCallback & battle
 			return false;
 		}
 
-		spellID = battle.getRandomBeneficialSpell(gameHandler->getRandomGenerator(), stack, subject);
+		spellID = battle.getRandomBeneficialSpell(owner->getRandomGenerator(battle), stack, subject);
 
 		if (spellID == SpellID::NONE)
 		{
@@ -935,7 +935,7 @@ void BattleActionProcessor::makeAttack(const CBattleInfoCallback & battle, const
 		auto diceSize = VLC->settings()->getVector(EGameSettings::COMBAT_GOOD_LUCK_DICE);
 		size_t diceIndex = std::min<size_t>(diceSize.size(), attackerLuck) - 1; // array index, so 0-indexed
 
-		if(diceSize.size() > 0 && gameHandler->getRandomGenerator().nextInt(1, diceSize[diceIndex]) == 1)
+		if(diceSize.size() > 0 && owner->getRandomGenerator(battle).nextInt(1, diceSize[diceIndex]) == 1)
 			bat.flags |= BattleAttack::LUCKY;
 	}
 
@@ -944,11 +944,11 @@ void BattleActionProcessor::makeAttack(const CBattleInfoCallback & battle, const
 		auto diceSize = VLC->settings()->getVector(EGameSettings::COMBAT_BAD_LUCK_DICE);
 		size_t diceIndex = std::min<size_t>(diceSize.size(), -attackerLuck) - 1; // array index, so 0-indexed
 
-		if(diceSize.size() > 0 && gameHandler->getRandomGenerator().nextInt(1, diceSize[diceIndex]) == 1)
+		if(diceSize.size() > 0 && owner->getRandomGenerator(battle).nextInt(1, diceSize[diceIndex]) == 1)
 			bat.flags |= BattleAttack::UNLUCKY;
 	}
 
-	if (gameHandler->getRandomGenerator().nextInt(99) < attacker->valOfBonuses(BonusType::DOUBLE_DAMAGE_CHANCE))
+	if (owner->getRandomGenerator(battle).nextInt(99) < attacker->valOfBonuses(BonusType::DOUBLE_DAMAGE_CHANCE))
 	{
 		bat.flags |= BattleAttack::DEATH_BLOW;
 	}
@@ -957,7 +957,7 @@ void BattleActionProcessor::makeAttack(const CBattleInfoCallback & battle, const
 	if(owner)
 	{
 		int chance = owner->valOfBonuses(BonusType::BONUS_DAMAGE_CHANCE, BonusSubtypeID(attacker->creatureId()));
-		if (chance > gameHandler->getRandomGenerator().nextInt(99))
+		if (chance > this->owner->getRandomGenerator(battle).nextInt(99))
 			bat.flags |= BattleAttack::BALLISTA_DOUBLE_DMG;
 	}
 
@@ -1101,7 +1101,7 @@ void BattleActionProcessor::makeAttack(const CBattleInfoCallback & battle, const
 			bsa.stackAttacked = attacker->unitId(); //invert
 			bsa.attackerID = defender->unitId();
 			bsa.damageAmount = totalDamage;
-			attacker->prepareAttacked(bsa, gameHandler->getRandomGenerator());
+			attacker->prepareAttacked(bsa, this->owner->getRandomGenerator(battle));
 
 			StacksInjured pack;
 			pack.battleID = battle.getBattle()->getBattleID();
@@ -1170,7 +1170,7 @@ void BattleActionProcessor::attackCasting(const CBattleInfoCallback & battle, bo
 				continue;
 
 			//check if spell should be cast (probability handling)
-			if(gameHandler->getRandomGenerator().nextInt(99) >= chance)
+			if(owner->getRandomGenerator(battle).nextInt(99) >= chance)
 				continue;
 
 			//casting
@@ -1279,7 +1279,7 @@ void BattleActionProcessor::handleDeathStare(const CBattleInfoCallback & battle,
 	double chanceToKill = singleCreatureKillChancePercent / 100.0;
 	vstd::amin(chanceToKill, 1); //cap at 100%
 	std::binomial_distribution<> distribution(attacker->getCount(), chanceToKill);
-	int killedCreatures = distribution(gameHandler->getRandomGenerator().getStdGenerator());
+	int killedCreatures = distribution(owner->getRandomGenerator(battle).getStdGenerator());
 
 	int maxToKill = (attacker->getCount() * singleCreatureKillChancePercent + 99) / 100;
 	vstd::amin(killedCreatures, maxToKill);
@@ -1329,7 +1329,7 @@ void BattleActionProcessor::handleAfterAttackCasting(const CBattleInfoCallback &
 	TConstBonusListPtr acidBreath = attacker->getBonuses(Selector::type()(BonusType::ACID_BREATH));
 	for(const auto & b : *acidBreath)
 	{
-		if(b->additionalInfo[0] > gameHandler->getRandomGenerator().nextInt(99))
+		if(b->additionalInfo[0] > owner->getRandomGenerator(battle).nextInt(99))
 			acidDamage += b->val;
 	}
 
@@ -1356,7 +1356,7 @@ void BattleActionProcessor::handleAfterAttackCasting(const CBattleInfoCallback &
 		double chanceToTrigger = attacker->valOfBonuses(BonusType::TRANSMUTATION) / 100.0f;
 		vstd::amin(chanceToTrigger, 1); //cap at 100%
 
-		if(gameHandler->getRandomGenerator().getDoubleRange(0, 1)() > chanceToTrigger)
+		if(owner->getRandomGenerator(battle).getDoubleRange(0, 1)() > chanceToTrigger)
 			return;
 
 		int bonusAdditionalInfo = attacker->getBonus(Selector::type()(BonusType::TRANSMUTATION))->additionalInfo[0];
@@ -1420,7 +1420,7 @@ void BattleActionProcessor::handleAfterAttackCasting(const CBattleInfoCallback &
 
 		vstd::amin(chanceToTrigger, 1); //cap trigger chance at 100%
 
-		if(gameHandler->getRandomGenerator().getDoubleRange(0, 1)() > chanceToTrigger)
+		if(owner->getRandomGenerator(battle).getDoubleRange(0, 1)() > chanceToTrigger)
 			return;
 
 		BattleStackAttacked bsa;
@@ -1429,7 +1429,7 @@ void BattleActionProcessor::handleAfterAttackCasting(const CBattleInfoCallback &
 		bsa.damageAmount = amountToDie * defender->getMaxHealth();
 		bsa.flags = BattleStackAttacked::SPELL_EFFECT;
 		bsa.spellID = SpellID::SLAYER;
-		defender->prepareAttacked(bsa, gameHandler->getRandomGenerator());
+		defender->prepareAttacked(bsa, owner->getRandomGenerator(battle));
 
 		StacksInjured si;
 		si.battleID = battle.getBattle()->getBattleID();
@@ -1457,8 +1457,8 @@ int64_t BattleActionProcessor::applyBattleEffects(const CBattleInfoCallback & ba
 		bai.unluckyStrike  = bat.unlucky();
 
 		auto range = battle.calculateDmgRange(bai);
-		bsa.damageAmount = battle.getBattle()->getActualDamage(range.damage, attackerState->getCount(), gameHandler->getRandomGenerator());
-		CStack::prepareAttacked(bsa, gameHandler->getRandomGenerator(), bai.defender->acquireState()); //calculate casualties
+		bsa.damageAmount = battle.getBattle()->getActualDamage(range.damage, attackerState->getCount(), owner->getRandomGenerator(battle));
+		CStack::prepareAttacked(bsa, owner->getRandomGenerator(battle), bai.defender->acquireState()); //calculate casualties
 	}
 
 	int64_t drainedLife = 0;
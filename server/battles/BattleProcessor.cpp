@@ -15,11 +15,13 @@
 #include "BattleResultProcessor.h"
 
 #include "../CGameHandler.h"
+#include "../TurnProfiler.h"
 #include "../queries/QueriesProcessor.h"
 #include "../queries/BattleQueries.h"
 
 #include "../../lib/CPlayerState.h"
 #include "../../lib/TerrainHandler.h"
+#include "../../lib/CRandomGenerator.h"
 #include "../../lib/battle/CBattleInfoCallback.h"
 #include "../../lib/battle/CObstacleInstance.h"
 #include "../../lib/battle/BattleInfo.h"
@@ -96,6 +98,7 @@ void BattleProcessor::restartBattlePrimary(const BattleID & battleID, const CArm
 	BattleCancelled bc;
 	bc.battleID = battleID;
 	gameHandler->sendAndApply(&bc);
+	randomGenerators.erase(battleID);
 
 	startBattlePrimary(army1, army2, tile, hero1, hero2, creatureBank, town);
 }
@@ -198,9 +201,22 @@ BattleID BattleProcessor::setupBattle(int3 tile, const CArmedInstance *armies[2]
 
 	gameHandler->sendAndApply(&bs);
 
+	randomGenerators[bs.battleID] = std::make_unique<CRandomGenerator>(gameHandler->getRandomGenerator().nextInt());
+
 	return bs.battleID;
 }
 
+CRandomGenerator & BattleProcessor::getRandomGenerator(const CBattleInfoCallback & battle)
+{
+	const BattleID battleID = battle.getBattle()->getBattleID();
+
+	// battles loaded from save do not have own stream yet
+	if (!randomGenerators.count(battleID))
+		randomGenerators[battleID] = std::make_unique<CRandomGenerator>(gameHandler->getRandomGenerator().nextInt());
+
+	return *randomGenerators.at(battleID);
+}
+
 bool BattleProcessor::checkBattleStateChanges(const CBattleInfoCallback & battle)
 {
 	//check if drawbridge state need to be changes
@@ -286,7 +302,11 @@ bool BattleProcessor::makePlayerBattleAction(const BattleID & battleID, PlayerCo
 
 	bool result = actionsProcessor->makePlayerBattleAction(*battle, player, ba);
 	if (gameHandler->gameState()->getBattle(battleID) != nullptr && !resultProcessor->battleIsEnding(*battle))
+	{
+		// includes actions of war machines and other units controlled by server
+		TurnProfiler::Scope profilerScope(gameHandler->profiler.get(), "battle", "battle flow", player);
 		flowProcessor->onActionMade(*battle, ba);
+	}
 	return result;
 }
 
@@ -315,6 +335,9 @@ void BattleProcessor::endBattleConfirm(const BattleID & battleID)
 void BattleProcessor::battleAfterLevelUp(const BattleID & battleID, const BattleResult &result)
 {
 	resultProcessor->battleAfterLevelUp(battleID, result);
+
+	if (gameHandler->gameState()->getBattle(battleID) == nullptr)
+		randomGenerators.erase(battleID);
 }
 
 void BattleProcessor::setGameHandler(CGameHandler * newGameHandler)
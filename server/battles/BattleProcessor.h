@@ -20,6 +20,7 @@ class int3;
 class CBattleInfoCallback;
 struct BattleResult;
 class BattleID;
+class CRandomGenerator;
 VCMI_LIB_NAMESPACE_END
 
 class CGameHandler;
@@ -40,6 +41,12 @@ class BattleProcessor : boost::noncopyable
 	std::unique_ptr<BattleFlowProcessor> flowProcessor;
 	std::unique_ptr<BattleResultProcessor> resultProcessor;
 
+	/// Separate random stream for each ongoing battle, seeded on battle start
+	/// Makes outcome of a battle independent from actions made in other, simultaneous battles
+	std::map<BattleID, std::unique_ptr<CRandomGenerator>> randomGenerators;
+
+	CRandomGenerator & getRandomGenerator(const CBattleInfoCallback & battle);
+
 	void updateGateState(const CBattleInfoCallback & battle);
 	void engageIntoBattle(PlayerColor player);
 
@@ -15,8 +15,10 @@
 #include "../queries/MapQueries.h"
 #include "../CGameHandler.h"
 #include "../CVCMIServer.h"
+#include "../TurnProfiler.h"
 
 #include "../../lib/CPlayerState.h"
+#include "../../lib/StartInfo.h"
 #include "../../lib/pathfinder/CPathfinder.h"
 #include "../../lib/pathfinder/PathfinderOptions.h"
 
@@ -43,6 +45,9 @@ std::vector<TurnOrderProcessor::PlayerPair> TurnOrderProcessor::computeContactSt
 	assert(actedPlayers.empty());
 	assert(actingPlayers.empty());
 
+	// heroes have moved and restored movement points since last update
+	reachabilityCache.clear();
+
 	for (auto left : awaitingPlayers)
 	{
 		for(auto right : awaitingPlayers)
@@ -54,6 +59,8 @@ std::vector<TurnOrderProcessor::PlayerPair> TurnOrderProcessor::computeContactSt
 				result.push_back({left, right});
 		}
 	}
+
+	reachabilityCache.clear();
 	return result;
 }
 
@@ -87,58 +94,52 @@ void TurnOrderProcessor::updateAndNotifyContactStatus()
 	blockedContacts = newBlockedContacts;
 }
 
-bool TurnOrderProcessor::playersInContact(PlayerColor left, PlayerColor right) const
+const TurnOrderProcessor::ReachableTiles & TurnOrderProcessor::getReachableTiles(PlayerColor player) const
 {
-	// TODO: refactor, cleanup and optimize
-
-	boost::multi_array<bool, 3> leftReachability;
-	boost::multi_array<bool, 3> rightReachability;
+	auto cached = reachabilityCache.find(player);
+	if (cached != reachabilityCache.end())
+		return cached->second;
 
 	int3 mapSize = gameHandler->getMapSize();
+	size_t tilesCount = static_cast<size_t>(mapSize.x) * mapSize.y * mapSize.z;
 
-	leftReachability.resize(boost::extents[mapSize.z][mapSize.x][mapSize.y]);
-	rightReachability.resize(boost::extents[mapSize.z][mapSize.x][mapSize.y]);
+	ReachableTiles & result = reachabilityCache[player];
+	result.resize((tilesCount + 63) / 64, 0);
 
-	const auto * leftInfo = gameHandler->getPlayerState(left, false);
-	const auto * rightInfo = gameHandler->getPlayerState(right, false);
+	const auto * playerInfo = gameHandler->getPlayerState(player, false);
+	if (playerInfo->heroes.empty())
+		return result;
+
+	// pathfinder resets all nodes before search, so same storage can be used for all heroes
+	CPathsInfo out(mapSize, nullptr);
 
-	for(const auto & hero : leftInfo->heroes)
+	for(const auto & hero : playerInfo->heroes)
 	{
-		CPathsInfo out(mapSize, hero);
 		auto config = std::make_shared<SingleHeroPathfinderConfig>(out, gameHandler->gameState(), hero);
 		config->options.ignoreGuards = true;
 		config->options.turnLimit = 1;
 		CPathfinder pathfinder(gameHandler->gameState(), config);
 		pathfinder.calculatePaths();
 
+		size_t index = 0;
 		for (int z = 0; z < mapSize.z; ++z)
 			for (int y = 0; y < mapSize.y; ++y)
-				for (int x = 0; x < mapSize.x; ++x)
+				for (int x = 0; x < mapSize.x; ++x, ++index)
 					if (out.getNode({x,y,z})->reachable())
-						leftReachability[z][x][y] = true;
+						result[index / 64] |= uint64_t(1) << (index % 64);
 	}
 
-	for(const auto & hero : rightInfo->heroes)
-	{
-		CPathsInfo out(mapSize, hero);
-		auto config = std::make_shared<SingleHeroPathfinderConfig>(out, gameHandler->gameState(), hero);
-		config->options.ignoreGuards = true;
-		config->options.turnLimit = 1;
-		CPathfinder pathfinder(gameHandler->gameState(), config);
-		pathfinder.calculatePaths();
+	return result;
+}
 
-		for (int z = 0; z < mapSize.z; ++z)
-			for (int y = 0; y < mapSize.y; ++y)
-				for (int x = 0; x < mapSize.x; ++x)
-					if (out.getNode({x,y,z})->reachable())
-						rightReachability[z][x][y] = true;
-	}
+bool TurnOrderProcessor::playersInContact(PlayerColor left, PlayerColor right) const
+{
+	const auto & leftReachability = getReachableTiles(left);
+	const auto & rightReachability = getReachableTiles(right);
 
-	for (int z = 0; z < mapSize.z; ++z)
-		for (int y = 0; y < mapSize.y; ++y)
-			for (int x = 0; x < mapSize.x; ++x)
-				if (leftReachability[z][x][y] && rightReachability[z][x][y])
-					return true;
+	for (size_t i = 0; i < leftReachability.size(); ++i)
+		if (leftReachability[i] & rightReachability[i])
+			return true;
 
 	return false;
 }
@@ -160,12 +161,14 @@ bool TurnOrderProcessor::computeCanActSimultaneously(PlayerColor active, PlayerC
 
 	if (gameHandler->hasBothPlayersAtSameConnection(active, waiting))
 	{
-		if (!gameHandler->getStartInfo()->simturnsInfo.allowHumanWithAI)
+		// only one human can play from single connection at a time
+		if (activeInfo->human && waitingInfo->human)
 			return false;
 
-		// only one AI and one human can play simultaneoulsy from single connection
-		if (activeInfo->human == waitingInfo->human)
+		if (activeInfo->human != waitingInfo->human && !gameHandler->getStartInfo()->simturnsInfo.allowHumanWithAI)
 			return false;
+
+		// each AI makes its turn in own thread, so multiple AI from single connection are only limited by simturns rules below
 	}
 
 	if (gameHandler->getDate(Date::DAY) < simturnsTurnsMinLimit())
@@ -252,6 +255,8 @@ void TurnOrderProcessor::doStartPlayerTurn(PlayerColor which)
 	//Note: on game load, "actingPlayer" might already contain list of players
 	actingPlayers.insert(which);
 	awaitingPlayers.erase(which);
+	if (gameHandler->profiler)
+		gameHandler->profiler->onTurnStarted(which);
 	gameHandler->onPlayerTurnStarted(which);
 
 	auto turnQuery = std::make_shared<TimerPauseQuery>(gameHandler, which);
@@ -273,6 +278,12 @@ void TurnOrderProcessor::doEndPlayerTurn(PlayerColor which)
 	actingPlayers.erase(which);
 	actedPlayers.insert(which);
 
+	if (gameHandler->profiler)
+	{
+		bool isAI = gameHandler->getStartInfo()->getIthPlayersSettings(which).isControlledByAI();
+		gameHandler->profiler->onTurnEnded(which, "turn of " + which.toString() + (isAI ? " (AI)" : " (human)"));
+	}
+
 	PlayerEndsTurn pet;
 	pet.player = which;
 	gameHandler->sendAndApply(&pet);
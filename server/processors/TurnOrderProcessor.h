@@ -37,6 +37,12 @@ class TurnOrderProcessor : boost::noncopyable
 
 	std::vector<PlayerPair> blockedContacts;
 
+	/// Tiles that can be reached by any hero of player within current turn, one bit per tile
+	using ReachableTiles = std::vector<uint64_t>;
+
+	/// Reachability of players, valid during single contact status update
+	mutable std::map<PlayerColor, ReachableTiles> reachabilityCache;
+
 	std::set<PlayerColor> awaitingPlayers;
 	std::set<PlayerColor> actingPlayers;
 	std::set<PlayerColor> actedPlayers;
@@ -47,6 +53,9 @@ class TurnOrderProcessor : boost::noncopyable
 	/// Returns date until which simturns must play unconditionally
 	int simturnsTurnsMinLimit() const;
 
+	/// Returns tiles reachable by heroes of player, computed once per contact status update
+	const ReachableTiles & getReachableTiles(PlayerColor player) const;
+
 	/// Returns true if players are close enough to each other for their heroes to meet on this turn
 	bool playersInContact(PlayerColor left, PlayerColor right) const;
 
@@ -11,6 +11,12 @@
 #include "QueriesProcessor.h"
 
 #include "CQuery.h"
+#include "../TurnProfiler.h"
+
+QueriesProcessor::QueriesProcessor(TurnProfiler * profiler)
+	: profiler(profiler)
+{
+}
 
 void QueriesProcessor::popQuery(PlayerColor player, QueryPtr query)
 {
@@ -24,7 +30,11 @@ void QueriesProcessor::popQuery(PlayerColor player, QueryPtr query)
 	queries[player] -= query;
 	auto nextQuery = topQuery(player);
 
-	query->onRemoval(player);
+	{
+		const CQuery & removedQuery = *query;
+		TurnProfiler::Scope profilerScope(profiler, "query", typeid(removedQuery), player);
+		query->onRemoval(player);
+	}
 
 	//Exposure on query below happens only if removal didn't trigger any new query
 	if(nextQuery && nextQuery == topQuery(player))
@@ -64,8 +74,12 @@ void QueriesProcessor::addQuery(QueryPtr query)
 	for(auto player : query->players)
 		addQuery(player, query);
 
+	const CQuery & addedQuery = *query;
 	for(auto player : query->players)
+	{
+		TurnProfiler::Scope profilerScope(profiler, "query", typeid(addedQuery), player);
 		query->onAdded(player);
+	}
 }
 
 void QueriesProcessor::addQuery(PlayerColor player, QueryPtr query)
@@ -12,6 +12,7 @@
 #include "../../lib/GameConstants.h"
 
 class CQuery;
+class TurnProfiler;
 using QueryPtr = std::shared_ptr<CQuery>;
 
 class QueriesProcessor
@@ -21,8 +22,11 @@ private:
 	void popQuery(PlayerColor player, QueryPtr query);
 
 	std::map<PlayerColor, std::vector<QueryPtr>> queries; //player => stack of queries
+	TurnProfiler * profiler;
 
 public:
+	explicit QueriesProcessor(TurnProfiler * profiler = nullptr);
+
 	void addQuery(QueryPtr query);
 	void popQuery(const CQuery &query);
 	void popQuery(QueryPtr query);
@@ -0,0 +1,109 @@
+/*
+ * JsonDocumentTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+#include "../lib/filesystem/Filesystem.h"
+#include "../lib/json/JsonDocument.h"
+
+static JsonDocument parseDocument(const std::string & text)
+{
+	return JsonDocument(reinterpret_cast<const std::byte *>(text.data()), text.size());
+}
+
+TEST(JsonDocumentTest, readsAllTypes)
+{
+	auto document = parseDocument(R"({"b" : true, "i" : -42, "f" : 1.5, "s" : "text", "n" : null, "v" : [1, 2, 3], "e" : {}})");
+	auto root = document.root();
+
+	EXPECT_TRUE(document.isValid());
+	EXPECT_TRUE(root.isStruct());
+	EXPECT_EQ(root.size(), 7);
+	EXPECT_TRUE(root["b"].Bool());
+	EXPECT_EQ(root["i"].Integer(), -42);
+	EXPECT_DOUBLE_EQ(root["f"].Float(), 1.5);
+	EXPECT_EQ(root["s"].String(), "text");
+	EXPECT_TRUE(root["n"].isNull());
+	EXPECT_TRUE(root["missing"].isNull());
+	EXPECT_EQ(root["v"].size(), 3);
+	EXPECT_EQ(root["v"][2].Integer(), 3);
+	EXPECT_TRUE(root["v"][3].isNull());
+	EXPECT_TRUE(root["e"].isStruct());
+	EXPECT_EQ(root["e"].size(), 0);
+}
+
+TEST(JsonDocumentTest, structEntriesAreSorted)
+{
+	auto document = parseDocument(R"({"c" : 3, "a" : 1, "b#override" : 2})");
+
+	std::vector<std::string_view> keys;
+	for(auto it = document.root().begin(); it != document.root().end(); ++it)
+		keys.push_back(it.key());
+
+	EXPECT_EQ(keys, std::vector<std::string_view>({"a", "b", "c"}));
+	EXPECT_TRUE(document.root().toJsonNode()["b"].getOverrideFlag());
+}
+
+static void expectSameAsJsonNode(const std::string & text)
+{
+	JsonNode node(reinterpret_cast<const std::byte *>(text.data()), text.size());
+	auto document = parseDocument(text);
+
+	EXPECT_EQ(node, document.root().toJsonNode()) << text;
+}
+
+TEST(JsonDocumentTest, duplicatedScalarKeepsLastValue)
+{
+	auto document = parseDocument(R"({"a" : 1, "a" : "text"})");
+
+	EXPECT_FALSE(document.isValid());
+	EXPECT_EQ(document.root().size(), 1);
+	EXPECT_EQ(document.root()["a"].String(), "text");
+
+	expectSameAsJsonNode(R"({"a" : 1, "a" : 2.5})");
+	expectSameAsJsonNode(R"({"a" : {"x" : 1}, "a" : null})");
+	expectSameAsJsonNode(R"({"a" : [1, 2], "a" : {"x" : 1}})");
+}
+
+TEST(JsonDocumentTest, duplicatedContainersAreMerged)
+{
+	auto document = parseDocument(R"({"s" : {"y" : 2}, "v" : [1], "s" : {"x" : 1}, "v" : [2, 3]})");
+	auto root = document.root();
+
+	EXPECT_EQ(root.size(), 2);
+	EXPECT_EQ(root["s"].size(), 2);
+	EXPECT_EQ(root["s"]["x"].Integer(), 1);
+	EXPECT_EQ(root["s"]["y"].Integer(), 2);
+	EXPECT_EQ(root["v"].size(), 3);
+	EXPECT_EQ(root["v"][2].Integer(), 3);
+
+	expectSameAsJsonNode(R"({"s" : {"y" : 2}, "v" : [1], "s" : {"x" : 1}, "v" : [2, 3]})");
+	expectSameAsJsonNode(R"({"s" : {"a" : {"b" : 1}, "c" : 2}, "s" : {"a" : {"d" : 3}, "c" : 4}})");
+	expectSameAsJsonNode(R"({"s" : {"a" : 1}, "s#override" : {"b" : 2}})");
+}
+
+TEST(JsonDocumentTest, configFilesMatchJsonNode)
+{
+	auto files = CResourceHandler::get()->getFilteredFiles([](const ResourcePath & path)
+	{
+		return path.getType() == EResType::JSON && boost::algorithm::starts_with(path.getName(), "CONFIG/");
+	});
+
+	EXPECT_FALSE(files.empty());
+
+	for(const auto & file : files)
+	{
+		auto input = CResourceHandler::get()->load(file)->readAll();
+
+		JsonNode node(reinterpret_cast<const std::byte *>(input.first.get()), input.second);
+		JsonDocument document(reinterpret_cast<const std::byte *>(input.first.get()), input.second);
+
+		EXPECT_EQ(node, document.root().toJsonNode()) << file.getName();
+	}
+}
@@ -0,0 +1,104 @@
+/*
+ * BonusChangesBatchTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+
+#include "../lib/bonuses/Bonus.h"
+#include "../lib/bonuses/CBonusSystemNode.h"
+
+namespace
+{
+	class UpdateCountingNode : public CBonusSystemNode
+	{
+	public:
+		int updates = 0;
+
+	protected:
+		void deferredUpdate() override
+		{
+			updates++;
+		}
+	};
+
+	class ExternalCountingNode : public CBonusSystemNode
+	{
+		int & updates;
+
+	public:
+		explicit ExternalCountingNode(int & updates)
+			: updates(updates)
+		{}
+
+	protected:
+		void deferredUpdate() override
+		{
+			updates++;
+		}
+	};
+
+	std::shared_ptr<Bonus> makeBonus(int value)
+	{
+		return std::make_shared<Bonus>(BonusDuration::PERMANENT, BonusType::PRIMARY_SKILL, BonusSource::OTHER, value, BonusSourceID(), BonusSubtypeID(PrimarySkill::ATTACK));
+	}
+}
+
+TEST(BonusChangesBatchTest, DefersUpdatesUntilOutermostBatchEnds)
+{
+	UpdateCountingNode node;
+
+	node.deferUpdate();
+	EXPECT_EQ(node.updates, 1);
+
+	{
+		CBonusSystemNode::ChangesBatch outer;
+		{
+			CBonusSystemNode::ChangesBatch inner;
+			node.deferUpdate();
+			node.deferUpdate();
+		}
+		node.deferUpdate();
+		EXPECT_EQ(node.updates, 1);
+	}
+	EXPECT_EQ(node.updates, 2);
+}
+
+TEST(BonusChangesBatchTest, QueriesInsideBatchSeeChanges)
+{
+	CBonusSystemNode parent;
+	CBonusSystemNode child;
+	child.attachTo(parent);
+
+	parent.addNewBonus(makeBonus(3));
+	EXPECT_EQ(child.valOfBonuses(BonusType::PRIMARY_SKILL), 3);
+
+	CBonusSystemNode::ChangesBatch batch;
+	int64_t version = child.getTreeVersion();
+
+	parent.addNewBonus(makeBonus(4));
+	EXPECT_NE(child.getTreeVersion(), version);
+	EXPECT_EQ(child.valOfBonuses(BonusType::PRIMARY_SKILL), 7);
+}
+
+TEST(BonusChangesBatchTest, DestroyedNodeIsNotUpdated)
+{
+	int destroyedNodeUpdates = 0;
+	UpdateCountingNode survivor;
+
+	{
+		CBonusSystemNode::ChangesBatch batch;
+		auto node = std::make_unique<ExternalCountingNode>(destroyedNodeUpdates);
+		node->deferUpdate();
+		survivor.deferUpdate();
+		node.reset();
+	}
+
+	EXPECT_EQ(destroyedNodeUpdates, 0);
+	EXPECT_EQ(survivor.updates, 1);
+}
@@ -0,0 +1,68 @@
+/*
+ * FogOfWarMapTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+
+#include "../lib/gameState/FogOfWarMap.h"
+
+TEST(FogOfWarMapTest, RevealMatchesDistanceFormulas)
+{
+	const int3 size(100, 70, 2);
+	const std::vector<int3> centers = { int3(0, 0, 0), int3(63, 30, 1), int3(64, 69, 0), int3(99, 35, 1) };
+
+	for(auto formula : { int3::DIST_2D, int3::DIST_MANHATTAN, int3::DIST_CHEBYSHEV, int3::DIST_2DSQ })
+	{
+		for(const int3 & center : centers)
+		{
+			for(int radius : { 0, 1, 5, 13, 80 })
+			{
+				FogOfWarMap fow(size);
+				fow.reveal(center, radius, formula);
+
+				int3 tile;
+				for(tile.z = 0; tile.z < size.z; tile.z++)
+					for(tile.y = 0; tile.y < size.y; tile.y++)
+						for(tile.x = 0; tile.x < size.x; tile.x++)
+						{
+							bool expected = tile.z == center.z && static_cast<int>(center.dist(tile, formula)) <= radius;
+							ASSERT_EQ(fow.isVisible(tile), expected) << tile.toString() << " from " << center.toString() << " radius " << radius;
+						}
+			}
+		}
+	}
+}
+
+TEST(FogOfWarMapTest, TilesRoundTripThroughRuns)
+{
+	FogOfWarMap fow(int3(130, 40, 2));
+	fow.reveal(int3(64, 20, 0), 10);
+	fow.reveal(int3(129, 0, 1), 7);
+	fow.setVisible(int3(3, 3, 1), true);
+
+	std::unordered_set<int3> visible;
+	fow.getTiles(visible, true);
+
+	std::unordered_set<int3> hidden;
+	fow.getTiles(hidden, false);
+	EXPECT_EQ(visible.size() + hidden.size(), 130 * 40 * 2);
+
+	auto runs = FogOfWarMap::encodeRuns(visible);
+	EXPECT_LT(runs.size(), visible.size() / 4);
+
+	std::unordered_set<int3> decoded;
+	FogOfWarMap::decodeRuns(runs, decoded);
+	EXPECT_EQ(decoded, visible);
+
+	FogOfWarMap restored(fow.size());
+	restored.setVisible(decoded, true);
+	std::unordered_set<int3> restoredVisible;
+	restored.getTiles(restoredVisible, true);
+	EXPECT_EQ(restoredVisible, visible);
+}
@@ -0,0 +1,146 @@
+/*
+ * CMapTileFlagsTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+
+#include "../lib/json/JsonNode.h"
+#include "../lib/mapObjects/ObjectTemplate.h"
+#include "../lib/mapping/CMap.h"
+#include "../lib/mapping/CMapEditManager.h"
+#include "../lib/serializer/CMemorySerializer.h"
+#include "../lib/TerrainHandler.h"
+#include "../lib/int3.h"
+
+// not used directly, but CMap::serialize can only be instantiated with complete types of serialized map members
+#include "../lib/bonuses/Limiters.h"
+#include "../lib/bonuses/Propagators.h"
+#include "../lib/bonuses/Updaters.h"
+#include "../lib/mapObjects/CGTownInstance.h"
+#include "../lib/mapObjects/CQuest.h"
+#include "../lib/mapObjects/MiscObjects.h"
+#include "../lib/CHeroHandler.h"
+#include "../lib/RiverHandler.h"
+#include "../lib/RoadHandler.h"
+
+static std::unique_ptr<CMap> createMap(int size)
+{
+	auto map = std::make_unique<CMap>(nullptr);
+	map->width = size;
+	map->height = size;
+	map->initTerrain();
+	map->getEditManager()->clearTerrain();
+	return map;
+}
+
+static void expectFlagsMatchTiles(const CMap & map)
+{
+	int3 pos;
+	for(pos.z = 0; pos.z < map.levels(); ++pos.z)
+	{
+		for(pos.x = 0; pos.x < map.width; ++pos.x)
+		{
+			for(pos.y = 0; pos.y < map.height; ++pos.y)
+			{
+				const TerrainTile & tile = map.getTile(pos);
+				const ui8 flags = map.getTileFlags(pos);
+
+				EXPECT_EQ(tile.terType->isPassable(), (flags & ETileFlag::PASSABLE) != 0);
+				EXPECT_EQ(tile.terType->isWater(), (flags & ETileFlag::WATER) != 0);
+				EXPECT_EQ(tile.terType->isLand(), (flags & ETileFlag::LAND) != 0);
+				EXPECT_EQ(tile.visitable, (flags & ETileFlag::VISITABLE) != 0);
+				EXPECT_EQ(tile.blocked, (flags & ETileFlag::BLOCKED) != 0);
+			}
+		}
+	}
+}
+
+TEST(MapTileFlags, FollowTerrainChanges)
+{
+	auto map = createMap(36);
+	expectFlagsMatchTiles(*map);
+
+	auto * editManager = map->getEditManager();
+
+	editManager->getTerrainSelection().selectRange(MapRect(int3(5, 5, 0), 10, 10));
+	editManager->drawTerrain(ETerrainId::WATER, 10);
+
+	editManager->getTerrainSelection().selectRange(MapRect(int3(5, 5, 1), 6, 6));
+	editManager->drawTerrain(ETerrainId::ROCK, 10);
+
+	EXPECT_TRUE(map->getTileFlags(int3(8, 8, 0)) & ETileFlag::WATER);
+	EXPECT_FALSE(map->getTileFlags(int3(8, 8, 1)) & ETileFlag::PASSABLE);
+	expectFlagsMatchTiles(*map);
+}
+
+/// Object of 3x2 tiles, visitable at its position, top-left tile is neither blocked nor visitable
+static std::unique_ptr<CGObjectInstance> createObject(const int3 & pos)
+{
+	JsonNode templateConfig;
+	templateConfig["mask"].Vector().emplace_back("VBB");
+	templateConfig["mask"].Vector().emplace_back("BBA");
+
+	auto appearance = std::make_shared<ObjectTemplate>();
+	appearance->readJson(templateConfig, false);
+
+	auto object = std::make_unique<CGObjectInstance>(nullptr);
+	object->ID = Obj::MINE;
+	object->pos = pos;
+	object->appearance = appearance;
+	return object;
+}
+
+TEST(MapTileFlags, FollowBlockingObjects)
+{
+	auto map = createMap(36);
+	auto object = createObject(int3(10, 10, 0));
+	auto overlapping = createObject(int3(11, 10, 0));
+
+	map->addBlockVisTiles(object.get());
+
+	EXPECT_EQ(map->getTileFlags(int3(10, 10, 0)) & (ETileFlag::VISITABLE | ETileFlag::BLOCKED), ETileFlag::VISITABLE | ETileFlag::BLOCKED);
+	EXPECT_EQ(map->getTileFlags(int3(9, 10, 0)) & (ETileFlag::VISITABLE | ETileFlag::BLOCKED), ETileFlag::BLOCKED);
+	EXPECT_EQ(map->getTileFlags(int3(8, 9, 0)) & (ETileFlag::VISITABLE | ETileFlag::BLOCKED), 0);
+	EXPECT_EQ(map->getTileFlags(int3(11, 10, 0)) & (ETileFlag::VISITABLE | ETileFlag::BLOCKED), 0);
+	expectFlagsMatchTiles(*map);
+
+	// tile stays blocked while any of objects on it blocks it
+	map->addBlockVisTiles(overlapping.get());
+	map->removeBlockVisTiles(object.get());
+
+	EXPECT_EQ(map->getTileFlags(int3(10, 10, 0)) & (ETileFlag::VISITABLE | ETileFlag::BLOCKED), ETileFlag::BLOCKED);
+	EXPECT_EQ(map->getTileFlags(int3(8, 10, 0)) & (ETileFlag::VISITABLE | ETileFlag::BLOCKED), 0);
+	EXPECT_EQ(map->getTileFlags(int3(11, 10, 0)) & (ETileFlag::VISITABLE | ETileFlag::BLOCKED), ETileFlag::VISITABLE | ETileFlag::BLOCKED);
+	expectFlagsMatchTiles(*map);
+
+	map->removeBlockVisTiles(overlapping.get());
+
+	EXPECT_EQ(map->getTileFlags(int3(10, 10, 0)) & (ETileFlag::VISITABLE | ETileFlag::BLOCKED), 0);
+	expectFlagsMatchTiles(*map);
+}
+
+TEST(MapTileFlags, RebuiltAfterSerialization)
+{
+	auto map = createMap(36);
+	auto * editManager = map->getEditManager();
+
+	editManager->getTerrainSelection().selectRange(MapRect(int3(5, 5, 0), 10, 10));
+	editManager->drawTerrain(ETerrainId::WATER, 10);
+
+	// tiles are changed directly, so flags of original map are outdated and only serialized tiles are source of truth
+	map->getTile(int3(20, 20, 0)).blocked = true;
+	map->getTile(int3(21, 20, 1)).visitable = true;
+
+	auto loaded = CMemorySerializer::deepCopy(*map);
+
+	EXPECT_TRUE(loaded->getTileFlags(int3(8, 8, 0)) & ETileFlag::WATER);
+	EXPECT_TRUE(loaded->getTileFlags(int3(20, 20, 0)) & ETileFlag::BLOCKED);
+	EXPECT_TRUE(loaded->getTileFlags(int3(21, 20, 1)) & ETileFlag::VISITABLE);
+	expectFlagsMatchTiles(*loaded);
+}
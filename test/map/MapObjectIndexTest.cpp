@@ -0,0 +1,80 @@
+/*
+ * MapObjectIndexTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+
+#include "../lib/CRandomGenerator.h"
+#include "../lib/mapping/MapObjectIndex.h"
+#include "../lib/mapObjects/CGObjectInstance.h"
+#include "../lib/mapObjects/ObjectTemplate.h"
+
+class MapObjectIndexTest : public ::testing::Test
+{
+public:
+	MapObjectIndex index;
+	std::vector<std::unique_ptr<CGObjectInstance>> objects;
+
+	const CGObjectInstance * createObject(MapObjectID type, const int3 & pos)
+	{
+		auto object = std::make_unique<CGObjectInstance>(nullptr);
+		object->ID = type;
+		object->pos = pos;
+		object->appearance = std::make_shared<ObjectTemplate>();
+		index.add(object.get());
+		objects.push_back(std::move(object));
+		return objects.back().get();
+	}
+
+	void SetUp() override
+	{
+		index.resize(int3(72, 72, 2));
+	}
+};
+
+TEST_F(MapObjectIndexTest, RangeQueryMatchesLinearSearch)
+{
+	CRandomGenerator rand(42);
+
+	for(int i = 0; i < 500; i++)
+		createObject(i % 2 ? Obj::MINE : Obj::BOAT, int3(rand.nextInt(71), rand.nextInt(71), rand.nextInt(1)));
+
+	for(int i = 0; i < 50; i++)
+	{
+		int3 center(rand.nextInt(71), rand.nextInt(71), rand.nextInt(1));
+		int radius = rand.nextInt(20);
+
+		std::set<const CGObjectInstance *> expected;
+		for(const auto & object : objects)
+			if(object->ID == Obj::MINE && object->pos.z == center.z && center.dist(object->pos, int3::DIST_2D) <= radius)
+				expected.insert(object.get());
+
+		auto found = index.getObjectsInRange(center, radius, MapObjectID(Obj::MINE));
+		EXPECT_EQ(std::set<const CGObjectInstance *>(found.begin(), found.end()), expected);
+	}
+}
+
+TEST_F(MapObjectIndexTest, NearestObjectOfType)
+{
+	const auto * farBoat = createObject(Obj::BOAT, int3(70, 70, 0));
+	const auto * nearBoat = createObject(Obj::BOAT, int3(30, 35, 1));
+	createObject(Obj::MINE, int3(10, 10, 0));
+
+	EXPECT_EQ(index.getNearestObject(int3(10, 10, 0), Obj::BOAT), nearBoat);
+	EXPECT_EQ(index.getNearestObject(int3(10, 10, 0), Obj::BOAT, [nearBoat](const CGObjectInstance * obj){ return obj != nearBoat; }), farBoat);
+	EXPECT_EQ(index.getNearestObject(int3(10, 10, 0), Obj::TOWN), nullptr);
+
+	index.remove(nearBoat);
+	EXPECT_EQ(index.getNearestObject(int3(10, 10, 0), Obj::BOAT), farBoat);
+
+	objects.front()->pos = int3(0, 0, 1);
+	index.add(farBoat);
+	EXPECT_EQ(index.getObjectsInRange(int3(0, 0, 1), 0), std::vector<const CGObjectInstance *>({farBoat}));
+	EXPECT_TRUE(index.getObjectsInRange(int3(70, 70, 0), 5).empty());
+}